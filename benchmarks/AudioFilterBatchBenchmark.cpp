@@ -0,0 +1,122 @@
+// --- AudioFilterBatchBenchmark: ns per filter for AudioFilter::calculateFilterCoeffsBatch( ) against
+//     one calculateFilterCoeffs( ) call per filter, per algorithm and for mixed algorithm lists, at each math tier
+//
+//     usage: AudioFilterBatchBenchmark [filters per batch]
+//
+//     parameter sets are random (fc 20 Hz - 20 kHz, Q 0.3 - 20, boost/cut -18 - +18 dB) at 48 kHz
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#include "include/AudioFilter.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	// --- in filterAlgorithm order
+	const char* kAlgorithmNames[] = {
+		"kLPF1P", "kLPF1", "kHPF1", "kLPF2", "kHPF2", "kBPF2", "kBPF2Boost", "kBSF2", "kButterLPF2", "kButterHPF2",
+		"kButterBPF2", "kButterBSF2", "kMMALPF2A", "kMMALPF2B", "kMMALPF2C", "kMMALPF2D", "kLowShelf", "kHiShelf",
+		"kNCQParaEQ", "kCQParaEQ", "kLWRLPF2", "kLWRHPF2", "kAPF1", "kAPF2", "kRM1", "kRM2", "kResonA", "kResonB",
+		"kMatchLP2A", "kMatchLP2B", "kMatchBP2A", "kMatchBP2B", "kImpInvLP1", "kImpInvLP2" };
+	const uint32_t kNumAlgorithms = sizeof(kAlgorithmNames) / sizeof(kAlgorithmNames[0]);
+
+	const mathAccuracy kTiers[] = { mathAccuracy::kExact, mathAccuracy::kHigh, mathAccuracy::kLow };
+	const double kSampleRate = 48000.0;
+
+	volatile double sink = 0.0;	///< keeps the timed loops alive
+
+	double randomRange(double low, double high)
+	{
+		return low + (high - low) * rand() / (double)RAND_MAX;
+	}
+
+	// --- ns per filter for the batch call and for the scalar loop, best of interleaved trials
+	void timeDesigns(const std::vector<AudioFilterParameters>& parameters, mathAccuracy accuracy, double& batchNs, double& scalarNs)
+	{
+		const uint32_t kTrials = 25;
+		const uint32_t count = (uint32_t)parameters.size();
+		const uint32_t repeats = 1 + 30000 / count;
+		std::vector<double> coeffs(count * numCoeffs);
+
+		batchNs = 1.0e9;
+		scalarNs = 1.0e9;
+		for (uint32_t trial = 0; trial < kTrials; trial++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (uint32_t r = 0; r < repeats; r++)
+				AudioFilter::calculateFilterCoeffsBatch(parameters.data(), count, kSampleRate, coeffs.data(), accuracy);
+			auto stop = std::chrono::steady_clock::now();
+			sink = sink + coeffs[0];
+			batchNs = fmin(batchNs, std::chrono::duration<double, std::nano>(stop - start).count() / ((double)repeats * count));
+
+			start = std::chrono::steady_clock::now();
+			for (uint32_t r = 0; r < repeats; r++)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					AudioFilter::calculateFilterCoeffs(parameters[i], kSampleRate, &coeffs[i * numCoeffs], accuracy);
+			}
+			stop = std::chrono::steady_clock::now();
+			sink = sink + coeffs[0];
+			scalarNs = fmin(scalarNs, std::chrono::duration<double, std::nano>(stop - start).count() / ((double)repeats * count));
+		}
+	}
+
+	void report(const char* name, const std::vector<AudioFilterParameters>& parameters)
+	{
+		printf("%-12s", name);
+		for (mathAccuracy accuracy : kTiers)
+		{
+			double batchNs = 0.0;
+			double scalarNs = 0.0;
+			timeDesigns(parameters, accuracy, batchNs, scalarNs);
+			printf("   %7.1f %7.1f %5.2fx", scalarNs, batchNs, scalarNs / batchNs);
+		}
+		printf("\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t count = argc > 1 ? (uint32_t)atoi(argv[1]) : 512;
+	if (count == 0)
+	{
+		fprintf(stderr, "usage: AudioFilterBatchBenchmark [filters per batch]\n");
+		return 1;
+	}
+
+	srand(1);
+	std::vector<AudioFilterParameters> parameters(count);
+	for (AudioFilterParameters& params : parameters)
+	{
+		params.fc = 20.0 * pow(1000.0, randomRange(0.0, 1.0));
+		params.Q = 0.3 * pow(20.0 / 0.3, randomRange(0.0, 1.0));
+		params.boostCut_dB = randomRange(-18.0, 18.0);
+		params.gr_index = rand() % 10;
+		params.k = randomRange(0.1, 4.0);
+	}
+
+	printf("%u filters per batch at %.0f Hz, best ns per filter: scalar loop, batch, speedup\n", count, kSampleRate);
+	printf("%-12s   %-21s   %-21s   %-21s\n", "algorithm", "kExact", "kHigh", "kLow");
+
+	for (uint32_t alg = 0; alg < kNumAlgorithms; alg++)
+	{
+		for (AudioFilterParameters& params : parameters)
+			params.algorithm = (filterAlgorithm)alg;
+		report(kAlgorithmNames[alg], parameters);
+	}
+
+	// --- a preset: groups of 8 bands sharing an algorithm
+	for (uint32_t i = 0; i < count; i++)
+		parameters[i].algorithm = i % 8 == 0 ? (filterAlgorithm)(rand() % kNumAlgorithms) : parameters[i - 1].algorithm;
+	report("preset", parameters);
+
+	// --- worst case: every filter a random algorithm
+	for (AudioFilterParameters& params : parameters)
+		params.algorithm = (filterAlgorithm)(rand() % kNumAlgorithms);
+	report("random", parameters);
+	return 0;
+}
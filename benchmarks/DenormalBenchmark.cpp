@@ -0,0 +1,107 @@
+// --- DenormalBenchmark: cost of decaying tails through a long AudioFilter cascade,
+//     with and without ScopedDenormalGuard
+//
+//     usage: DenormalBenchmark [seconds of silence]
+//
+//     build once as is (kernel underflow checks on) and once with
+//     FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE defined (checks compiled out) to see all four cases;
+//     benchmarks/CMakeLists.txt builds both, as DenormalBenchmark and DenormalBenchmarkHardwareFlush
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "include/AudioFilter.h"
+#include "include/DenormalGuard.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	const uint32_t kNumSections = 32;
+	const uint32_t kBlockSize = 256;
+	const double kSampleRate = 48000.0;
+
+	// --- resonant lowpass and peaking sections with slow decays, so the tails spend a long time
+	//     in the denormal range once the input goes silent
+	void setupCascade(std::vector<AudioFilter>& cascade)
+	{
+		for (uint32_t i = 0; i < kNumSections; i++)
+		{
+			AudioFilterParameters params;
+			params.algorithm = (i % 2) ? filterAlgorithm::kCQParaEQ : filterAlgorithm::kLPF2;
+			params.fc = 60.0 + 55.0 * i;
+			params.Q = 2.0 + (i % 4);
+			params.boostCut_dB = 6.0;
+
+			cascade[i].reset(kSampleRate);
+			cascade[i].setParameters(params);
+		}
+	}
+
+	// --- one burst of noise, then silence; returns ns/sample for the silent tail
+	double runTail(bool useGuard, uint32_t silentSamples, double& checksum)
+	{
+		std::vector<AudioFilter> cascade(kNumSections);
+		setupCascade(cascade);
+
+		std::vector<double> buffer(kBlockSize);
+		srand(1);
+		for (uint32_t i = 0; i < kBlockSize; i++)
+			buffer[i] = 2.0 * rand() / (double)RAND_MAX - 1.0;
+
+		for (uint32_t section = 0; section < kNumSections; section++)
+			cascade[section].processBlock(buffer.data(), buffer.data(), kBlockSize);
+
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t done = 0; done < silentSamples; done += kBlockSize)
+		{
+			// --- the guard is scoped per block, as it would be in an audio callback
+			if (useGuard)
+			{
+				ScopedDenormalGuard guard;
+				for (uint32_t i = 0; i < kBlockSize; i++)
+					buffer[i] = 0.0;
+				for (uint32_t section = 0; section < kNumSections; section++)
+					cascade[section].processBlock(buffer.data(), buffer.data(), kBlockSize);
+			}
+			else
+			{
+				for (uint32_t i = 0; i < kBlockSize; i++)
+					buffer[i] = 0.0;
+				for (uint32_t section = 0; section < kNumSections; section++)
+					cascade[section].processBlock(buffer.data(), buffer.data(), kBlockSize);
+			}
+			checksum += buffer[0];
+		}
+		auto stop = std::chrono::steady_clock::now();
+
+		double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+		return ns / silentSamples;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	double seconds = argc > 1 ? atof(argv[1]) : 30.0;
+	uint32_t silentSamples = (uint32_t)(seconds * kSampleRate);
+
+#ifdef FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE
+	const char* kernelChecks = "off";
+#else
+	const char* kernelChecks = "on";
+#endif
+
+	double checksum = 0.0;
+	double unguarded = runTail(false, silentSamples, checksum);
+	double guarded = runTail(true, silentSamples, checksum);
+
+	printf("cascade: %u AudioFilter sections, %.1f s of decaying tail at %.0f Hz, block %u\n",
+		kNumSections, seconds, kSampleRate, kBlockSize);
+	printf("kernel underflow checks: %s, hardware flush supported: %s\n",
+		kernelChecks, ScopedDenormalGuard::isSupported() ? "yes" : "no");
+	printf("without guard: %8.2f ns/sample\n", unguarded);
+	printf("with guard:    %8.2f ns/sample\n", guarded);
+	printf("(checksum %g)\n", checksum);
+	return 0;
+}
@@ -0,0 +1,215 @@
+// --- FastMathAccuracy: error and speed of the FastMath.h accuracy tiers against libm
+//
+//     usage: FastMathAccuracy [sample rate]
+//
+//     1) max relative error and ns/call of each approximation over the argument ranges the design
+//        equations use
+//     2) per AudioFilter algorithm: max magnitude response deviation from the kExact design (dB,
+//        20 Hz - 20 kHz, where the exact response is above -60 dB) over an fc/Q/boost-cut grid, and
+//        ns per coefficient update at each tier
+//     3) the ZVAFilter prewarp g and the WDF warped fc, as relative error
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "include/AudioFilter.h"
+#include "include/FastMath.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	// --- in filterAlgorithm order
+	const char* kAlgorithmNames[] = {
+		"kLPF1P", "kLPF1", "kHPF1", "kLPF2", "kHPF2", "kBPF2", "kBPF2Boost", "kBSF2", "kButterLPF2", "kButterHPF2",
+		"kButterBPF2", "kButterBSF2", "kMMALPF2A", "kMMALPF2B", "kMMALPF2C", "kMMALPF2D", "kLowShelf", "kHiShelf",
+		"kNCQParaEQ", "kCQParaEQ", "kLWRLPF2", "kLWRHPF2", "kAPF1", "kAPF2", "kRM1", "kRM2", "kResonA", "kResonB",
+		"kMatchLP2A", "kMatchLP2B", "kMatchBP2A", "kMatchBP2B", "kImpInvLP1", "kImpInvLP2" };
+	const uint32_t kNumAlgorithms = sizeof(kAlgorithmNames) / sizeof(kAlgorithmNames[0]);
+
+	const mathAccuracy kTiers[] = { mathAccuracy::kExact, mathAccuracy::kHigh, mathAccuracy::kLow };
+	const char* kTierNames[] = { "kExact", "kHigh", "kLow" };
+
+	volatile double sink = 0.0;	///< keeps the timed loops alive
+
+	double relativeError(double approx, double exact)
+	{
+		if (exact == 0.0)
+			return fabs(approx);
+		return fabs(approx / exact - 1.0);
+	}
+
+	// --- max relative error against f(x) over [x0, x1], and ns/call, for g(x) at all three tiers
+	template <typename Exact, typename Approx>
+	void reportFunction(const char* name, double x0, double x1, Exact exact, Approx approx)
+	{
+		const uint32_t kPoints = 1000000;
+		std::vector<double> args(kPoints);
+		for (uint32_t i = 0; i < kPoints; i++)
+			args[i] = x0 + (x1 - x0) * (i + 0.5) / kPoints;
+
+		printf("%-8s [%9.3g, %9.3g]", name, x0, x1);
+		for (uint32_t t = 0; t < 3; t++)
+		{
+			double maxError = 0.0;
+			for (uint32_t i = 0; i < kPoints; i++)
+				maxError = fmax(maxError, relativeError(approx(args[i], kTiers[t]), exact(args[i])));
+
+			double sum = 0.0;
+			auto start = std::chrono::steady_clock::now();
+			for (uint32_t i = 0; i < kPoints; i++)
+				sum += approx(args[i], kTiers[t]);
+			auto stop = std::chrono::steady_clock::now();
+			sink = sink + sum;
+
+			double ns = std::chrono::duration<double, std::nano>(stop - start).count() / kPoints;
+			printf("  %-6s %8.2g %6.2f ns", kTierNames[t], maxError, ns);
+		}
+		printf("\n");
+	}
+
+	// --- |H(e^jw)| of a { a0, a1, a2, b1, b2, c0, d0 } array
+	double magnitude(const double* c, double w)
+	{
+		std::complex<double> z1 = std::polar(1.0, -w);
+		std::complex<double> z2 = z1 * z1;
+		std::complex<double> h = (c[a0] + c[a1] * z1 + c[a2] * z2) / (1.0 + c[b1] * z1 + c[b2] * z2);
+		return std::abs(c[d0] + c[c0] * h);
+	}
+
+	void reportAudioFilter(double sampleRate)
+	{
+		// --- parameter grid
+		std::vector<AudioFilterParameters> grid;
+		const double Qs[] = { 0.3, 0.707, 2.0, 8.0, 20.0 };
+		const double boostCuts[] = { -12.0, 0.0, 12.0 };
+		for (double fc = 20.0; fc <= 20000.0; fc *= 1.33)
+		{
+			for (double Q : Qs)
+			{
+				for (double boostCut : boostCuts)
+				{
+					AudioFilterParameters params;
+					params.fc = fc;
+					params.Q = Q;
+					params.boostCut_dB = boostCut;
+					grid.push_back(params);
+				}
+			}
+		}
+
+		// --- response measurement points, 20 Hz - 20 kHz
+		std::vector<double> omegas;
+		for (double f = 20.0; f <= 20000.0 && f < sampleRate / 2.0; f *= 1.05)
+			omegas.push_back(kTwoPi * f / sampleRate);
+
+		printf("\nAudioFilter at %.0f Hz: max |H| deviation from kExact (dB), ns per coefficient update\n", sampleRate);
+		printf("%-12s %10s %10s   %8s %8s %8s\n", "algorithm", "kHigh dB", "kLow dB", "kExact", "kHigh", "kLow");
+
+		for (uint32_t alg = 0; alg < kNumAlgorithms; alg++)
+		{
+			for (AudioFilterParameters& params : grid)
+				params.algorithm = (filterAlgorithm)alg;
+
+			double maxDeviation_dB[3] = { 0.0, 0.0, 0.0 };
+			for (const AudioFilterParameters& params : grid)
+			{
+				double exact[numCoeffs];
+				AudioFilter::calculateFilterCoeffs(params, sampleRate, exact, mathAccuracy::kExact);
+
+				for (uint32_t t = 1; t < 3; t++)
+				{
+					double approx[numCoeffs];
+					AudioFilter::calculateFilterCoeffs(params, sampleRate, approx, kTiers[t]);
+
+					for (double w : omegas)
+					{
+						double exactMagnitude = magnitude(exact, w);
+						if (!std::isfinite(exactMagnitude) || exactMagnitude < 0.001)
+							continue;
+						double deviation_dB = fabs(20.0 * log10(magnitude(approx, w) / exactMagnitude));
+						if (!std::isfinite(deviation_dB))
+							deviation_dB = 1.0e9;
+						maxDeviation_dB[t] = fmax(maxDeviation_dB[t], deviation_dB);
+					}
+				}
+			}
+
+			double nsPerUpdate[3] = { 0.0, 0.0, 0.0 };
+			for (uint32_t t = 0; t < 3; t++)
+			{
+				const uint32_t kRepeats = 20;
+				double coeffs[numCoeffs];
+				double sum = 0.0;
+				auto start = std::chrono::steady_clock::now();
+				for (uint32_t r = 0; r < kRepeats; r++)
+				{
+					for (const AudioFilterParameters& params : grid)
+					{
+						AudioFilter::calculateFilterCoeffs(params, sampleRate, coeffs, kTiers[t]);
+						sum += coeffs[a0] + coeffs[b1];
+					}
+				}
+				auto stop = std::chrono::steady_clock::now();
+				sink = sink + sum;
+				nsPerUpdate[t] = std::chrono::duration<double, std::nano>(stop - start).count() / (kRepeats * grid.size());
+			}
+
+			printf("%-12s %10.2g %10.2g   %8.1f %8.1f %8.1f\n", kAlgorithmNames[alg],
+				maxDeviation_dB[1], maxDeviation_dB[2], nsPerUpdate[0], nsPerUpdate[1], nsPerUpdate[2]);
+		}
+	}
+
+	void reportWarping(double sampleRate)
+	{
+		printf("\nprewarping at %.0f Hz, 20 Hz - 20 kHz: max relative error\n", sampleRate);
+
+		double zvaError[3] = { 0.0, 0.0, 0.0 };
+		double wdfError[3] = { 0.0, 0.0, 0.0 };
+		for (double fc = 20.0; fc <= 20000.0 && fc < sampleRate / 2.0; fc *= 1.001)
+		{
+			// --- ZVAFilter::calculateFilterCoeffs( ) g and the WDF filters' warped fc
+			double zvaArg = fc * kPi / sampleRate / 2.0;
+			double wdfArg = kPi * fc / sampleRate;
+			for (uint32_t t = 1; t < 3; t++)
+			{
+				zvaError[t] = fmax(zvaError[t], relativeError(fastTan(zvaArg, kTiers[t]), tan(zvaArg)));
+				wdfError[t] = fmax(wdfError[t], relativeError(fc * fastTan(wdfArg, kTiers[t]) / wdfArg, fc * tan(wdfArg) / wdfArg));
+			}
+		}
+
+		printf("%-14s kHigh %8.2g  kLow %8.2g\n", "ZVAFilter g", zvaError[1], zvaError[2]);
+		printf("%-14s kHigh %8.2g  kLow %8.2g\n", "WDF warped fc", wdfError[1], wdfError[2]);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	double sampleRate = argc > 1 ? atof(argv[1]) : 48000.0;
+	if (!(sampleRate > 0.0))
+	{
+		fprintf(stderr, "usage: FastMathAccuracy [sample rate]\n");
+		return 1;
+	}
+
+	printf("function [range]: max relative error against libm and ns/call per tier\n");
+	reportFunction("tan", 1.0e-4, kPi / 2.0 - 1.0e-3, [](double x) { return tan(x); },
+		[](double x, mathAccuracy m) { return fastTan(x, m); });
+	reportFunction("sin", -kPi, kPi, [](double x) { return sin(x); },
+		[](double x, mathAccuracy m) { return fastSin(x, m); });
+	reportFunction("cos", -kPi, kPi, [](double x) { return cos(x); },
+		[](double x, mathAccuracy m) { return fastCos(x, m); });
+	reportFunction("exp", -40.0, 10.0, [](double x) { return exp(x); },
+		[](double x, mathAccuracy m) { return fastExp(x, m); });
+	reportFunction("pow10", -6.0, 6.0, [](double x) { return pow(10.0, x); },
+		[](double x, mathAccuracy m) { return fastPow10(x, m); });
+	reportFunction("log10", 1.001, 1.0e4, [](double x) { return log10(x); },
+		[](double x, mathAccuracy m) { return fastLog10(x, m); });
+
+	reportAudioFilter(sampleRate);
+	reportWarping(sampleRate);
+	return 0;
+}
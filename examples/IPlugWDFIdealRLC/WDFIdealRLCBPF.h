@@ -23,6 +23,8 @@ Control I/F:
 #include "include/WdfEnumsStructs.h"
 #include "include/WdfSeriesAdaptor.h"
 #include "include/WdfParallelTerminatedAdaptor.h"
+#include "include/FastMath.h"
+#include "include/FrequencyResponse.h"
 
 using namespace fxobjects;
 
@@ -108,11 +110,11 @@ public:
 			if (wdfParameters.frequencyWarping)
 			{
 				double arg = (kPi * fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz * (tan(arg) / arg);
+				fc_Hz = fc_Hz * (fastTan(arg, designAccuracy) / arg);
 			}
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0 * kPi * fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q) * (pow(inductorValue / 1.0e-6, 0.5));
+			inductorValue = 1.0 / (1.0e-6 * pow((2.0 * kPi * fc_Hz), 2.0));
+			resistorValue = (1.0 / wdfParameters.Q) * (fastSqrt(inductorValue / 1.0e-6, designAccuracy));
 
 			seriesAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
 			parallelTerminatedAdaptor_R.setComponentValue(resistorValue);
@@ -120,6 +122,39 @@ public:
 		}
 	}
 
+	/** set the math tier for the frequency warping, see FastMath.h; takes effect at the next setParameters( ) */
+	/**
+	\param _accuracy kExact (libm), kHigh (about 1e-7) or kLow (about 1e-4 relative error)
+	*/
+	void setMathAccuracy(mathAccuracy _accuracy) { designAccuracy = _accuracy; }
+
+	/** get the math tier */
+	mathAccuracy getMathAccuracy() { return designAccuracy; }
+
+	/** magnitude and phase of the current component values, evaluated from the circuit's transfer function
+		H(s) = RC*s/(beta*LC*s^2 + RC*s + beta) (C = 1uF, Rs = 0, open load): the WDF components are bilinear
+		(trapezoidal) models, so the response is that of -H(s) with s = 2*fs*(1 - z^-1)/(1 + z^-1); the output
+		is inverted. WdfSeriesLC gives R_L + 1/R_C as its port resistance (R_L = 2*fs*L, R_C = 1/(2*fs*C)), so its
+		impedance is that of the ideal series LC scaled by beta = (R_L + 1/R_C)/(R_L + R_C): same center frequency,
+		different Q. See FrequencyResponse.h. */
+	/**
+	\param frequencies count frequencies in Hz
+	\param count number of frequencies
+	\param magnitude_dB receives count magnitudes in dB
+	\param phase receives count phases in radians; may be nullptr
+	*/
+	void getFrequencyResponse(const double* frequencies, uint32_t count, double* magnitude_dB, double* phase = nullptr)
+	{
+		// --- WdfSeriesLC impedance scaling
+		double portRL = 2.0 * inductorValue * sampleRate;
+		double portRC = 1.0 / (2.0 * 1.0e-6 * sampleRate);
+		double beta = (portRL + 1.0 / portRC) / (portRL + portRC);
+
+		double coeffArray[numCoeffs] = { 0.0 };
+		bilinearTransformCoeffs(0.0, -resistorValue * 1.0e-6, 0.0, beta, resistorValue * 1.0e-6, beta * inductorValue * 1.0e-6, 2.0 * sampleRate, coeffArray);
+		getBiquadFrequencyResponse(coeffArray, sampleRate, frequencies, count, magnitude_dB, phase);
+	}
+
 protected:
 	WDFParameters wdfParameters;	///< object parameters
 
@@ -128,4 +163,7 @@ protected:
 	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_R; ///< adaptor for R
 
 	double sampleRate = 1.0;
+	mathAccuracy designAccuracy = mathAccuracy::kExact;	///< math tier for the frequency warping
+	double resistorValue = 2.251131e2;		///< current R, for getFrequencyResponse( )
+	double inductorValue = 2.533e-2;		///< current L, for getFrequencyResponse( )
 };
\ No newline at end of file
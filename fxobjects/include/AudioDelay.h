@@ -24,11 +24,14 @@ Control I/F:
 
 namespace fxobjects
 {
-    class AudioDelay : public IAudioSignalProcessor
+    /** AudioDelay with SampleType (float or double) delay lines; float halves the memory traffic
+        of long delays. AudioDelay is BasicAudioDelay<double>. */
+    template <typename SampleType = double>
+    class BasicAudioDelay : public IAudioSignalProcessor
     {
     public:
-        AudioDelay() {}		/* C-TOR */
-        ~AudioDelay() {}	/* D-TOR */
+        BasicAudioDelay() {}		/* C-TOR */
+        ~BasicAudioDelay() {}	/* D-TOR */
     
     public:
         /** reset members to initialized state */
@@ -71,6 +74,12 @@ namespace fxobjects
             return output;
         }
     
+        /** process MONO audio delay in blocks; feedback and mix values are decoded once per block */
+        virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+    
+        /** process MONO audio delay in blocks, double precision version */
+        virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+    
         /** return true: this object can also process frames */
         virtual bool canProcessAudioFrame() { return true; }
     
@@ -217,6 +226,25 @@ namespace fxobjects
         }
     
     private:
+        /** block worker, shared by the float and double overrides */
+        template <typename BufferType>
+        void processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+        {
+            // --- use left feedback for mono processing
+            const double feedback = parameters.leftFeedback_Pct / 100.0;
+            const double delay = delayInSamples_L;
+            const double dry = dryMix;
+            const double wet = wetMix;
+    
+            for (uint32_t i = 0; i < n; i++)
+            {
+                double xn = in[i];
+                double yn = delayBuffer_L.readBuffer(delay);
+                delayBuffer_L.writeBuffer(xn + feedback*yn);
+                out[i] = (BufferType)(dry*xn + wet*yn);
+            }
+        }
+    
         AudioDelayParameters parameters; ///< object parameters
     
         double sampleRate = 0.0;		///< current sample rate
@@ -228,8 +256,10 @@ namespace fxobjects
         double wetMix = 0.707; ///< wet output default = -3dB
         double dryMix = 0.707; ///< dry output default = -3dB
     
-        // --- delay buffer of doubles
-        CircularBuffer<double> delayBuffer_L;	///< LEFT delay buffer of doubles
-        CircularBuffer<double> delayBuffer_R;	///< RIGHT delay buffer of doubles
+        // --- delay buffers of SampleType
+        CircularBuffer<SampleType> delayBuffer_L;	///< LEFT delay buffer
+        CircularBuffer<SampleType> delayBuffer_R;	///< RIGHT delay buffer
     };
+
+    using AudioDelay = BasicAudioDelay<double>;
 } // namespace fxobjects
\ No newline at end of file
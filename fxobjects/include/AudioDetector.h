@@ -26,11 +26,14 @@ Control I/F:
 namespace fxobjects
 {
     
-    class AudioDetector : public IAudioSignalProcessor
+    /** AudioDetector with the envelope recursion in SampleType (float or double) precision;
+        AudioDetector is BasicAudioDetector<double>. */
+    template <typename SampleType = double>
+    class BasicAudioDetector : public IAudioSignalProcessor
     {
     public:
-        AudioDetector() {}	/* C-TOR */
-        ~AudioDetector() {}	/* D-TOR */
+        BasicAudioDetector() {}	/* C-TOR */
+        ~BasicAudioDetector() {}	/* D-TOR */
     
     public:
         /** set sample rate dependent time constants and clear last envelope output value */
@@ -51,8 +54,11 @@ namespace fxobjects
         */
         virtual double processAudioSample(double xn)
         {
+            // --- parameter changes since the last sample
+            updateTimeConstants();
+
             // --- all modes do Full Wave Rectification
-            double input = fabs(xn);
+            SampleType input = (SampleType)fabs(xn);
     
             // --- square it for MS and RMS
             if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
@@ -60,7 +66,7 @@ namespace fxobjects
                 input *= input;
     
             // --- to store current
-            double currEnvelope = 0.0;
+            SampleType currEnvelope = 0.0;
     
             // --- do the detection with attack or release applied
             if (input > lastEnvelope)
@@ -69,14 +75,14 @@ namespace fxobjects
                 currEnvelope = releaseTime * (lastEnvelope - input) + input;
     
             // --- we are recursive so need to check underflow
-            checkFloatUnderflow(currEnvelope);
+            checkKernelUnderflow(currEnvelope);
     
             // --- bound them; can happen when using pre-detector gains of more than 1.0
             if (audioDetectorParameters.clampToUnityMax)
-                currEnvelope = fmin(currEnvelope, 1.0);
+                currEnvelope = fmin(currEnvelope, (SampleType)1.0);
     
             // --- can not be (-)
-            currEnvelope = fmax(currEnvelope, 0.0);
+            currEnvelope = fmax(currEnvelope, (SampleType)0.0);
     
             // --- store envelope prior to sqrt for RMS version
             lastEnvelope = currEnvelope;
@@ -99,6 +105,12 @@ namespace fxobjects
             return 20.0*log10(currEnvelope);
         }
     
+        /** detect a block of samples; the detect mode and output options are decoded once per block */
+        virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+    
+        /** detect a block of samples, double precision version */
+        virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+    
         /** get parameters: note use of custom structure for passing param data */
         /**
         \return AudioDetectorParameters custom data structure
@@ -108,18 +120,19 @@ namespace fxobjects
             return audioDetectorParameters;
         }
     
-        /** set parameters: note use of custom structure for passing param data */
+        /** set parameters: note use of custom structure for passing param data; new attack or release
+            times are only recorded here, the exp( ) for the time constants runs once before the next sample
+            or block, however often they change in between */
         /**
         \param AudioDetectorParameters custom data structure
         */
         void setParameters(const AudioDetectorParameters& parameters)
         {
+            if (parameters.attackTime_mSec != audioDetectorParameters.attackTime_mSec ||
+                parameters.releaseTime_mSec != audioDetectorParameters.releaseTime_mSec)
+                timeConstantsDirty = true;
+
             audioDetectorParameters = parameters;
-    
-            // --- update structure
-            setAttackTime(audioDetectorParameters.attackTime_mSec, true);
-            setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
-    
         }
     
         /** set sample rate - our time constants depend on it */
@@ -130,17 +143,82 @@ namespace fxobjects
     
             sampleRate = _sampleRate;
     
-            // --- recalculate RC time-constants
+            // --- flag RC time-constants for update
+            timeConstantsDirty = true;
+        }
+
+        /** recalculate the RC time-constants now if they are out of date; processing calls this first */
+        /**
+        \return true if the time-constants were recalculated
+        */
+        bool updateTimeConstants()
+        {
+            if (!timeConstantsDirty)
+                return false;
+
+            timeConstantsDirty = false;
             setAttackTime(audioDetectorParameters.attackTime_mSec, true);
             setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
+            return true;
         }
     
     protected:
+        /** block worker, shared by the float and double overrides */
+        template <typename BufferType>
+        void processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+        {
+            // --- parameter changes since the last block
+            updateTimeConstants();
+
+            const bool squareInput = audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
+                                     audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS;
+            const bool doSqrt = audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS;
+            const bool clampToUnityMax = audioDetectorParameters.clampToUnityMax;
+            const bool detect_dB = audioDetectorParameters.detect_dB;
+            const SampleType attack = attackTime;
+            const SampleType release = releaseTime;
+            SampleType envelope = lastEnvelope;
+    
+            for (uint32_t i = 0; i < n; i++)
+            {
+                // --- full wave rectification, square for MS and RMS
+                SampleType input = (SampleType)fabs((double)in[i]);
+                if (squareInput)
+                    input *= input;
+    
+                // --- attack or release
+                SampleType currEnvelope = input > envelope ? attack * (envelope - input) + input
+                                                       : release * (envelope - input) + input;
+                checkKernelUnderflow(currEnvelope);
+    
+                if (clampToUnityMax)
+                    currEnvelope = fmin(currEnvelope, (SampleType)1.0);
+                currEnvelope = fmax(currEnvelope, (SampleType)0.0);
+    
+                // --- store envelope prior to sqrt for RMS version
+                envelope = currEnvelope;
+    
+                // --- output stage in double, as processAudioSample( ); the same pow( ) call, so -0 also
+                //     comes out as +0
+                double detected = currEnvelope;
+                if (doSqrt)
+                    detected = pow(detected, 0.5);
+    
+                if (detect_dB)
+                    detected = detected <= 0 ? -96.0 : 20.0*log10(detected);
+    
+                out[i] = (BufferType)detected;
+            }
+    
+            lastEnvelope = envelope;
+        }
+    
         AudioDetectorParameters audioDetectorParameters; ///< parameters for object
-        double attackTime = 0.0;	///< attack time coefficient
-        double releaseTime = 0.0;	///< release time coefficient
+        SampleType attackTime = 0.0;	///< attack time coefficient
+        SampleType releaseTime = 0.0;	///< release time coefficient
         double sampleRate = 44100;	///< stored sample rate
-        double lastEnvelope = 0.0;	///< output register
+        SampleType lastEnvelope = 0.0;	///< output register
+        bool timeConstantsDirty = true;	///< attackTime/releaseTime are out of date
     
         /** set our internal atack time coefficients based on times and sample rate */
         // replaced declaration with full definition
@@ -164,4 +242,6 @@ namespace fxobjects
             releaseTime = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (release_in_ms * sampleRate * 0.001));
         }
     };
+
+    using AudioDetector = BasicAudioDetector<double>;
 } // namespace fxobjects
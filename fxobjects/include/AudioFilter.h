@@ -1,20 +1,47 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include "EnumsAndStructs.h"
 #include "IAudioSignalProcessor.h"
 #include "Biquad.h"
+#include "AudioFilterCoeffTable.h"
+#include "FastMath.h"
+#include "AudioFilterDesign.h"
+#include "FrequencyResponse.h"
 
 namespace fxobjects
 {
 	
-	class AudioFilter : public IAudioSignalProcessor
+	/** AudioFilter with the biquad running in SampleType (float or double) precision; the designed
+		coefficients and the IAudioSignalProcessor interface stay double. AudioFilter is BasicAudioFilter<double>. */
+	template <typename SampleType = double>
+	class BasicAudioFilter : public IAudioSignalProcessor
 	{
 	public:
-		AudioFilter() {}		/* C-TOR */
-		~AudioFilter() {}		/* D-TOR */
+		BasicAudioFilter() {}		/* C-TOR */
+		~BasicAudioFilter() {}		/* D-TOR */
+
+		/** --- construct with coefficients designed ahead of time, e.g. bakeAudioFilterCoeffs( ) in a constant
+			expression (AudioFilterDesign.h): the object is ready to process without running the design equations.
+			reset( ) at the same sample rate keeps these coefficients; setSampleRate( ) and new parameters redesign as usual. */
+		/**
+		\param parameters the parameters the coefficients were designed for
+		\param _sampleRate the sample rate they were designed for
+		\param designedCoeffs { a0, a1, a2, b1, b2, c0, d0 }
+		*/
+		BasicAudioFilter(const AudioFilterParameters& parameters, double _sampleRate, const std::array<double, numCoeffs>& designedCoeffs)
+		{
+			audioFilterParameters = parameters;
+			sampleRate = _sampleRate;
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				coeffArray[i] = designedCoeffs[i];
+			biquad.setCoefficients(coeffArray);
+			coeffsDirty = false;
+		}
 	
 		// --- IAudioSignalProcessor
-		/** --- set sample rate, then update coeffs */
+		/** --- set sample rate; a new rate redesigns before the next sample is processed */
 		virtual bool reset(double _sampleRate)
 		{
 			BiquadParameters bqp = biquad.getParameters();
@@ -24,6 +51,8 @@ namespace fxobjects
 			//	bqp.biquadCalcType = biquadAlgorithm::kDirect;
 			biquad.setParameters(bqp);
 	
+			if (sampleRate != _sampleRate)
+				coeffsDirty = true;
 			sampleRate = _sampleRate;
 			return biquad.reset(_sampleRate);
 		}
@@ -34,11 +63,17 @@ namespace fxobjects
 		/** process input x(n) through the filter to produce return value y(n) */
 		virtual double processAudioSample(double xn);
 	
+		/** process a block through the filter; the dry/wet mix is decoded once per block */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+	
+		/** process a block through the filter, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+	
 		/** --- sample rate change necessarily requires recalculation */
 		virtual void setSampleRate(double _sampleRate)
 		{
 			sampleRate = _sampleRate;
-			calculateFilterCoeffs();
+			coeffsDirty = true;
 		}
 	
 		/** --- get parameters */
@@ -46,17 +81,21 @@ namespace fxobjects
 	
 		AudioFilterParameters& getParametersRef() { return audioFilterParameters; }
 	
+		/** --- call after writing to getParametersRef( ); the design runs before the next sample is processed */
 		void updateParameters()
 		{
 			// --- don't allow 0 or (-) values for Q
 			if (audioFilterParameters.Q <= 0)
 				audioFilterParameters.Q = 0.707;
 	
-			// --- update coeffs
-			calculateFilterCoeffs();
+			// --- flag coeffs for update
+			coeffsDirty = true;
+			pendingRampLength = 0;
 		}
 	
-		/** --- set parameters */
+		/** --- set parameters; this only records them: the design equations run once, in the next
+			processAudioSample( ) or processBlock( ) (or updateCoefficients( )), however many times the
+			parameters were set in between */
 		void setParameters(const AudioFilterParameters& parameters)
 		{
 			if (audioFilterParameters.algorithm != parameters.algorithm ||
@@ -76,19 +115,180 @@ namespace fxobjects
 			if (audioFilterParameters.Q <= 0)
 				audioFilterParameters.Q = 0.707;
 	
-			// --- update coeffs
-			calculateFilterCoeffs();
+			// --- flag coeffs for update
+			coeffsDirty = true;
+			pendingRampLength = 0;
+		}
+	
+		/** --- set parameters, ramping linearly from the current coefficients to the new design over rampLength
+			samples; the design equations run once, deferred like setParameters( ), not once per sample. The
+			last write before processing wins, ramped or not. */
+		/**
+		\param parameters new filter parameters
+		\param rampLength ramp time in samples; 0 behaves like setParameters( )
+		*/
+		void setParametersRamped(const AudioFilterParameters& parameters, uint32_t rampLength)
+		{
+			if (audioFilterParameters.algorithm != parameters.algorithm ||
+				audioFilterParameters.boostCut_dB != parameters.boostCut_dB ||
+				audioFilterParameters.fc != parameters.fc ||
+				audioFilterParameters.Q != parameters.Q ||
+				audioFilterParameters.gr_index != parameters.gr_index ||
+				audioFilterParameters.k != parameters.k)
+			{
+				// --- save new params
+				audioFilterParameters = parameters;
+			}
+			else
+				return;
+
+			// --- don't allow 0 or (-) values for Q
+			if (audioFilterParameters.Q <= 0)
+				audioFilterParameters.Q = 0.707;
+
+			// --- flag coeffs for update; the biquad walks to the new design from wherever it is then
+			coeffsDirty = true;
+			pendingRampLength = rampLength;
+		}
+
+		/** --- run the deferred design now if parameters, sample rate, math tier or table use changed since the
+			last one; processing calls this first, so it is only needed to have the coefficients ready ahead of
+			time, e.g. before a block on the audio thread that must not design */
+		/**
+		\return true if the coefficients were recalculated
+		*/
+		bool updateCoefficients()
+		{
+			if (!coeffsDirty)
+				return false;
+
+			coeffsDirty = false;
+			if (pendingRampLength == 0)
+				return calculateFilterCoeffs();
+
+			// --- design the target, then let the biquad walk to it
+			uint32_t rampLength = pendingRampLength;
+			pendingRampLength = 0;
+			if (!designFilterCoeffs())
+				return false;
+
+			biquad.setCoefficientsRamped(coeffArray, rampLength);
+			return true;
+		}
+
+		/** --- true if a design is waiting for the next updateCoefficients( ) */
+		bool getCoefficientsDirty() { return coeffsDirty; }
+
+		/** --- the design equations without an object: write the { a0, a1, a2, b1, b2, c0, d0 } array for
+			a parameter set and sample rate; returns false if the algorithm is not decoded */
+		/**
+		\param accuracy tier for the tan/exp/sin/cos/pow math, see FastMath.h
+		*/
+		static bool calculateFilterCoeffs(const AudioFilterParameters& parameters, double sampleRate, double* coeffArray,
+			mathAccuracy accuracy = mathAccuracy::kExact);
+
+		/** --- the design equations for many parameter sets at once, e.g. a preset recall: in the kHigh and kLow tiers,
+			runs of one algorithm (1st/2nd order LPF/HPF, BPF boost, Butterworth LPF/HPF, LWR, shelves, non constant
+			Q para EQ) that cover two aligned blocks of 8 sets, which every run of 23 or more does, run the
+			transcendental math vectorized across the run; everything else, and everything at kExact, is one
+			calculateFilterCoeffs( ) call per set, so kExact gives the same coefficients. The list is not
+			reordered: keep the sets of one algorithm together. Does not allocate. */
+		/**
+		\param parameters count parameter sets
+		\param count number of parameter sets
+		\param sampleRate sample rate for all sets
+		\param coeffArrays receives count { a0, a1, a2, b1, b2, c0, d0 } arrays back to back; algorithms that are not
+		decoded get the pass-through array
+		\param accuracy tier for the tan/exp/sin/cos/pow math, see FastMath.h
+		*/
+		static void calculateFilterCoeffsBatch(const AudioFilterParameters* parameters, uint32_t count, double sampleRate,
+			double* coeffArrays, mathAccuracy accuracy = mathAccuracy::kExact);
+
+		/** --- recalculate the coefficients of many filters for their current parameters, sample rate and math tier
+			with calculateFilterCoeffsBatch( ), e.g. after reset( ) at a new sample rate or after setting each filter's
+			getParametersRef( ); filters using the coefficient tables are updated one at a time. Pending designs,
+			including ramps, are replaced by the batch result. */
+		/**
+		\param filters count filters
+		\param count number of filters
+		*/
+		static void updateFilters(BasicAudioFilter* const* filters, uint32_t count);
+
+		/** --- trade coefficient accuracy for design speed: kHigh/kLow replace the libm calls in the design
+			equations with the FastMath.h approximations (about 1e-7 / 1e-4 relative error). The coefficient
+			tables are always built with kExact. */
+		/**
+		\param _accuracy the math tier for subsequent designs
+		*/
+		void setMathAccuracy(mathAccuracy _accuracy)
+		{
+			designAccuracy = _accuracy;
+
+			// --- flag coeffs for update
+			coeffsDirty = true;
+		}
+
+		/** --- the math tier used by the design equations */
+		mathAccuracy getMathAccuracy() { return designAccuracy; }
+
+		/** --- opt in to the shared AudioFilterCoeffTable for this algorithm and sample rate: parameter updates
+			interpolate the precomputed table instead of running the design equations. Algorithms without a table
+			and parameters outside its grid still get the exact design. The first object to use a table builds it;
+			see AudioFilterCoeffTable::getTable( ) to do that ahead of time. */
+		/**
+		\param enable true to use the tables
+		*/
+		void setCoeffTableEnabled(bool enable)
+		{
+			useCoeffTable = enable;
+			if (!useCoeffTable)
+				coeffTable = nullptr;
+
+			// --- flag coeffs for update
+			coeffsDirty = true;
+		}
+
+		/** --- true if parameter updates use the coefficient tables */
+		bool getCoeffTableEnabled() { return useCoeffTable; }
+
+		/** --- get the current coefficient array { a0, a1, a2, b1, b2, c0, d0 }, e.g. to load BiquadN */
+		const double* getCoefficients()
+		{
+			updateCoefficients();
+			return &coeffArray[0];
 		}
 	
+		/** --- magnitude and phase of the current design, evaluated from coeffArray rather than measured; see
+			FrequencyResponse.h */
+		/**
+		\param frequencies count frequencies in Hz
+		\param count number of frequencies
+		\param magnitude_dB receives count magnitudes in dB
+		\param phase receives count phases in radians; may be nullptr
+		*/
+		void getFrequencyResponse(const double* frequencies, uint32_t count, double* magnitude_dB, double* phase = nullptr)
+		{
+			updateCoefficients();
+			getBiquadFrequencyResponse(coeffArray, sampleRate, frequencies, count, magnitude_dB, phase);
+		}
+
 		/** --- helper for Harma filters (phaser) */
-		double getG_value() { return biquad.getG_value(); }
+		double getG_value()
+		{
+			updateCoefficients();
+			return biquad.getG_value();
+		}
 	
 		/** --- helper for Harma filters (phaser) */
-		double getS_value() { return biquad.getS_value(); }
+		double getS_value()
+		{
+			updateCoefficients();
+			return biquad.getS_value();
+		}
 	
 	protected:
 		// --- our calculator
-		Biquad biquad; ///< the biquad object
+		BasicBiquad<SampleType> biquad; ///< the biquad object
 	
 		// --- array to hold coeffs (we need them too)
 		double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }; ///< our local copy of biquad coeffs
@@ -96,10 +296,111 @@ namespace fxobjects
 		// --- object parameters
 		AudioFilterParameters audioFilterParameters; ///< parameters
 		double sampleRate = 44100.0; ///< current sample rate
+
+		// --- optional shared coefficient table
+		bool useCoeffTable = false; ///< interpolate coefficients from coeffTable
+		std::shared_ptr<const AudioFilterCoeffTable> coeffTable = nullptr; ///< table for the current algorithm and sample rate
+		mathAccuracy designAccuracy = mathAccuracy::kExact; ///< math tier for the design equations
+
+		// --- deferred design
+		bool coeffsDirty = true; ///< coeffArray is out of date; designed by the next updateCoefficients( )
+		uint32_t pendingRampLength = 0; ///< ramp length for the pending design, 0 to set it directly
 	
 		/** --- function to recalculate coefficients due to a change in filter parameters */
 		bool calculateFilterCoeffs();
-	private:
-		static constexpr double gainReduction[10] = { 2750.0, 263.0, 124.0, 78.0, 55.0, 50.0, 30.0, 23.0, 17.0, 12.0, };
+
+		/** --- fill coeffArray from the coefficient table if enabled, otherwise (or off the grid) with the design equations */
+		bool designFilterCoeffs();
+	
+		/** --- block worker: (dry) + (processed) = x(n)*d0 + y(n)*c0, with d0 = 0, c0 = 1 skipping the mix */
+		template <typename BufferType>
+		void processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+		{
+			// --- parameter changes since the last block
+			updateCoefficients();
+
+			// --- coefficient ramp in progress: the mix moves with the biquad coefficients
+			uint32_t rampSamples = biquad.getRampSamplesRemaining();
+			if (rampSamples > 0)
+			{
+				uint32_t count = rampSamples < n ? rampSamples : n;
+				processRampT(in, out, count);
+				in += count;
+				out += count;
+				n -= count;
+
+				if (n == 0)
+					return;
+			}
+
+			const double dry = coeffArray[d0];
+			const double wet = coeffArray[c0];
+	
+			// --- no mix, let the biquad write straight to the output
+			if (dry == 0.0 && wet == 1.0)
+			{
+				biquad.processBlock(in, out, n);
+				return;
+			}
+	
+			// --- work in chunks so the dry signal survives in-place processing
+			SampleType xBuffer[BLOCK_SCRATCH_LENGTH];
+			SampleType yBuffer[BLOCK_SCRATCH_LENGTH];
+			for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+			{
+				uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+				for (uint32_t i = 0; i < count; i++)
+					xBuffer[i] = in[offset + i];
+	
+				biquad.processBlock(xBuffer, yBuffer, count);
+	
+				for (uint32_t i = 0; i < count; i++)
+					out[offset + i] = (BufferType)(dry * xBuffer[i] + wet * yBuffer[i]);
+			}
+		}
+
+		/** --- ramp worker: as above with c0/d0 stepped per sample in lockstep with the biquad ramp */
+		template <typename BufferType>
+		void processRampT(const BufferType* in, BufferType* out, uint32_t n)
+		{
+			const SampleType* increments = biquad.getRampIncrements();
+			const SampleType dryIncrement = increments[d0];
+			const SampleType wetIncrement = increments[c0];
+			SampleType dry = biquad.getCoefficients()[d0];
+			SampleType wet = biquad.getCoefficients()[c0];
+			uint32_t rampSamples = biquad.getRampSamplesRemaining();
+
+			SampleType xBuffer[BLOCK_SCRATCH_LENGTH];
+			SampleType yBuffer[BLOCK_SCRATCH_LENGTH];
+			for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+			{
+				uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+				for (uint32_t i = 0; i < count; i++)
+					xBuffer[i] = in[offset + i];
+
+				biquad.processBlock(xBuffer, yBuffer, count);
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					// --- last step lands exactly on the target (our coeffArray)
+					if (--rampSamples == 0)
+					{
+						dry = (SampleType)coeffArray[d0];
+						wet = (SampleType)coeffArray[c0];
+					}
+					else
+					{
+						dry += dryIncrement;
+						wet += wetIncrement;
+					}
+					out[offset + i] = (BufferType)(dry * xBuffer[i] + wet * yBuffer[i]);
+				}
+			}
+		}
+
+		/** --- updateFilters( ) view of a filter list, see AudioFilterBatch.cpp */
+		struct FilterListAccess;
 	};
+
+	using AudioFilter = BasicAudioFilter<double>;
 } // namespace fxobjects
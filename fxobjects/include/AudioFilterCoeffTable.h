@@ -0,0 +1,88 @@
+/**
+\class AudioFilterCoeffTable
+\ingroup FX-Objects
+\brief
+The AudioFilterCoeffTable object holds precomputed AudioFilter coefficients for one algorithm at one sample rate,
+on a log-spaced fc grid and, where the algorithm uses them, a log-spaced Q grid and a linear boost/cut grid.
+lookup( ) interpolates the { a0, a1, a2, b1, b2, c0, d0 } array between the nearest grid points, which replaces
+the tan/exp/cos/pow of the design equations with a few bit operations and multiply-adds per parameter update.
+The "log" grids are uniform in exponent + (mantissa - 1), a piecewise linear log2 that needs no log2( ) call
+to index; points per octave therefore vary by up to 2:1 across each octave.
+
+Tables are shared read-only by every AudioFilter in the process: getTable( ) returns the one table for an
+(algorithm, sample rate) pair and builds it on first use. Building allocates and runs the design equations over
+the whole grid (about 10 msec and 6 MB at 48 kHz for the fc/Q/boost-cut tables, under 1 MB otherwise), so call
+getTable( ) from a non-realtime thread ahead of time when an algorithm or sample rate change could happen on the
+audio thread.
+
+Since the biquad stability region is convex, interpolating between stable grid designs gives a stable filter.
+Parameters outside the grid, and the algorithms that depend on more than fc/Q/boostCut_dB (kRM1, kRM2 use k and
+kMMALPF2D uses gr_index), are not tabulated: lookup( ) returns false and the caller computes the exact design.
+
+Control I/F:
+- AudioFilter::setCoeffTableEnabled( ) opts an AudioFilter in
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "EnumsAndStructs.h"
+
+namespace fxobjects
+{
+	class AudioFilterCoeffTable
+	{
+	public:
+		// --- grid definition
+		static constexpr double kMinFc = 10.0;				///< lowest tabulated fc (Hz)
+		static constexpr double kMaxFcRatio = 0.45;			///< highest tabulated fc as a fraction of the sample rate
+		static constexpr double kFcPointsPerOctave = 16.0;	///< fc grid density
+		static constexpr double kMinQ = 0.1;				///< lowest tabulated Q
+		static constexpr double kMaxQ = 40.0;				///< highest tabulated Q
+		static constexpr double kQPointsPerOctave = 4.0;	///< Q grid density
+		static constexpr double kMinBoostCut_dB = -24.0;	///< lowest tabulated boost/cut
+		static constexpr double kMaxBoostCut_dB = 24.0;		///< highest tabulated boost/cut
+		static constexpr double kBoostCutStep_dB = 3.0;		///< boost/cut grid spacing
+
+		/** get the shared table for an algorithm and sample rate, building it on first use;
+			returns nullptr for algorithms that are not tabulated. Thread safe, but may allocate. */
+		static std::shared_ptr<const AudioFilterCoeffTable> getTable(filterAlgorithm algorithm, double sampleRate);
+
+		/** true if the algorithm depends only on fc, Q and boostCut_dB and can be tabulated */
+		static bool isTabulated(filterAlgorithm algorithm);
+
+		/** interpolate the coefficient array for a parameter set */
+		/**
+		\param parameters filter parameters; the algorithm must match the table
+		\param coeffArray receives { a0, a1, a2, b1, b2, c0, d0 }
+		\return false if the parameters are outside the grid (coeffArray is untouched)
+		*/
+		bool lookup(const AudioFilterParameters& parameters, double* coeffArray) const;
+
+		/** the algorithm this table was built for */
+		filterAlgorithm getAlgorithm() const { return algorithm; }
+
+		/** the sample rate this table was built for */
+		double getSampleRate() const { return sampleRate; }
+
+		/** memory used by the coefficient grid in bytes */
+		size_t getSizeInBytes() const { return table.size() * sizeof(double); }
+
+		/** use getTable( ) */
+		AudioFilterCoeffTable(filterAlgorithm _algorithm, double _sampleRate);
+
+	protected:
+		filterAlgorithm algorithm = filterAlgorithm::kLPF2;	///< tabulated algorithm
+		double sampleRate = 44100.0;	///< tabulated sample rate
+		double log2MinFc = 0.0;			///< grid origin, pseudo log2 of kMinFc
+		double log2MinQ = 0.0;			///< grid origin, pseudo log2 of kMinQ
+		uint32_t numFc = 0;				///< fc grid points
+		uint32_t numQ = 1;				///< Q grid points, 1 if Q is not used
+		uint32_t numBoostCut = 1;		///< boost/cut grid points, 1 if boost/cut is not used
+
+		/** [boostCut][Q][fc][coeff] */
+		std::vector<double> table;
+	};
+} // namespace fxobjects
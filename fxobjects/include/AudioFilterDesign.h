@@ -0,0 +1,1127 @@
+/**
+\file AudioFilterDesign.h
+\ingroup FX-Functions
+\brief
+The AudioFilter design equations as function templates, usable in constant expressions.
+
+- designAudioFilter<algorithm, Math>( ) is one algorithm's equations, selected at compile time
+- designAudioFilter<Math>( ) decodes parameters.algorithm at run time and calls the matching design
+- isFirstOrderAlgorithm( ) and usesDryWetMix( ) tell which coefficients a design can leave at 0 (a2, b2) or
+  at pass-through (c0 = 1, d0 = 0), so AudioFilterT can drop them from its kernel
+- bakeAudioFilterCoeffs( ) runs a design with ConstexprDesignMath and returns the coefficient array, so a filter
+  whose algorithm, fc, Q and sample rate are known at compile time gets its coefficients from the binary
+
+The Math policy supplies sin, cos, tan, exp, cosh, log10, pow10 and sqrt. FastDesignMath<accuracy> forwards to
+the FastMath.h tiers and is what AudioFilter uses at run time; ConstexprDesignMath evaluates the same functions
+with constexpr range reduction and series, to within a few ulp of the C library (it is not bit-identical to
+kExact). Parameters that would give the C library a domain error, e.g. sqrt of a negative number in the
+matched designs at low Q, stop a constant evaluation with a compile error rather than producing a NaN array.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include "EnumsAndStructs.h"
+#include "Constants.h"
+#include "FastMath.h"
+
+namespace fxobjects
+{
+	/** --- true if the algorithm's design always has a2 = b2 = 0, so a one-pole/one-zero kernel runs it */
+	constexpr bool isFirstOrderAlgorithm(filterAlgorithm algorithm)
+	{
+		return algorithm == filterAlgorithm::kLPF1P || algorithm == filterAlgorithm::kLPF1 ||
+			algorithm == filterAlgorithm::kHPF1 || algorithm == filterAlgorithm::kLowShelf ||
+			algorithm == filterAlgorithm::kHiShelf || algorithm == filterAlgorithm::kAPF1 ||
+			algorithm == filterAlgorithm::kRM1 || algorithm == filterAlgorithm::kImpInvLP1;
+	}
+
+	/** --- true if the algorithm's design sets the dry/wet mix (c0, d0); all others leave c0 = 1, d0 = 0 */
+	constexpr bool usesDryWetMix(filterAlgorithm algorithm)
+	{
+		return algorithm == filterAlgorithm::kLowShelf || algorithm == filterAlgorithm::kHiShelf ||
+			algorithm == filterAlgorithm::kNCQParaEQ;
+	}
+
+	/** --- gain reduction divisors for kMMALPF2D, indexed by AudioFilterParameters::gr_index */
+	constexpr double kMMAGainReduction[10] = { 2750.0, 263.0, 124.0, 78.0, 55.0, 50.0, 30.0, 23.0, 17.0, 12.0, };
+
+	/** --- math policy for run time designs: the FastMath.h functions at one accuracy tier */
+	template <mathAccuracy accuracy>
+	struct FastDesignMath
+	{
+		static double sin(double x) { return fastSin<accuracy>(x); }
+		static double cos(double x) { return fastCos<accuracy>(x); }
+		static double tan(double x) { return fastTan<accuracy>(x); }
+		static double exp(double x) { return fastExp<accuracy>(x); }
+		static double cosh(double x) { return fastCosh<accuracy>(x); }
+		static double log10(double x) { return fastLog10<accuracy>(x); }
+		static double pow10(double x) { return fastPow10<accuracy>(x); }
+		static double sqrt(double x) { return fastSqrt<accuracy>(x); }
+	};
+
+	/** --- math policy for constant expressions; see the file notes for accuracy */
+	struct ConstexprDesignMath
+	{
+		static constexpr double sin(double x)
+		{
+			double r = 0.0;
+			switch (reduceHalfPi(x, r))
+			{
+			case 0: return sinSeries(r);
+			case 1: return cosSeries(r);
+			case 2: return -sinSeries(r);
+			default: return -cosSeries(r);
+			}
+		}
+
+		static constexpr double cos(double x)
+		{
+			double r = 0.0;
+			switch (reduceHalfPi(x, r))
+			{
+			case 0: return cosSeries(r);
+			case 1: return -sinSeries(r);
+			case 2: return -cosSeries(r);
+			default: return sinSeries(r);
+			}
+		}
+
+		static constexpr double tan(double x) { return sin(x) / cos(x); }
+
+		static constexpr double exp(double x)
+		{
+			if (x > 709.78)
+				return std::numeric_limits<double>::infinity();
+			if (x < -745.2)
+				return 0.0;
+
+			// --- x = k ln2 + r, |r| <= ln2/2, ln2 split so that k * kLn2High is exact
+			const double kLn2High = 6.93147180369123816490e-01;
+			const double kLn2Low = 1.90821492927058770002e-10;
+			double kf = x * fastmath::kLog2e;
+			int64_t k = (int64_t)(kf < 0.0 ? kf - 0.5 : kf + 0.5);
+			double r = (x - k * kLn2High) - k * kLn2Low;
+
+			// --- Taylor series to r^16, below half an ulp for |r| <= ln2/2
+			double sum = 1.0;
+			for (int n = 16; n > 0; n--)
+				sum = 1.0 + sum * r / n;
+
+			// --- times 2^k
+			for (; k > 0; k--)
+				sum *= 2.0;
+			for (; k < 0; k++)
+				sum *= 0.5;
+			return sum;
+		}
+
+		static constexpr double cosh(double x) { return 0.5 * (exp(x) + exp(-x)); }
+
+		static constexpr double log10(double x)
+		{
+			if (x == std::numeric_limits<double>::infinity())
+				return x;
+
+			if (!(x > 0.0))
+				return domainError(x);
+
+			// --- x = m 2^e with m in [sqrt(1/2), sqrt(2))
+			double m = x;
+			int e = 0;
+			while (m >= kSqrtTwo)
+			{
+				m *= 0.5;
+				e++;
+			}
+			while (m < 0.5 * kSqrtTwo)
+			{
+				m *= 2.0;
+				e--;
+			}
+
+			// --- ln(m) = 2 atanh(s), s = (m - 1)/(m + 1), |s| < 0.172
+			double s = (m - 1.0) / (m + 1.0);
+			double s2 = s * s;
+			double sum = 0.0;
+			for (int n = 31; n > 1; n -= 2)
+				sum = s2 * (1.0 / n + sum);
+			double lnM = 2.0 * s * (1.0 + sum);
+			return (e * fastmath::kLn2 + lnM) * (1.0 / fastmath::kLn10);
+		}
+
+		static constexpr double pow10(double x) { return exp(x * fastmath::kLn10); }
+
+		static constexpr double sqrt(double x)
+		{
+			if (x == 0.0 || x == std::numeric_limits<double>::infinity())
+				return x;
+
+			if (!(x > 0.0))
+				return domainError(x);
+
+			// --- scale into [1, 4), Newton from the midpoint, scale back
+			double m = x;
+			double scale = 1.0;
+			while (m >= 4.0)
+			{
+				m *= 0.25;
+				scale *= 2.0;
+			}
+			while (m < 1.0)
+			{
+				m *= 4.0;
+				scale *= 0.5;
+			}
+
+			double y = 0.5 * (1.0 + m);
+			for (int i = 0; i < 8; i++)
+				y = 0.5 * (y + m / y);
+			return y * scale;
+		}
+
+	private:
+		/** --- NaN at run time; 0/0 is not a constant expression, so a constant evaluation stops here */
+		static constexpr double domainError(double x) { return (x - x) / (x - x); }
+
+		/** --- x = r + q pi/2 with |r| <= pi/4; returns q mod 4. Three part pi/2 so the reduction is exact for
+			the arguments the designs use */
+		static constexpr int reduceHalfPi(double x, double& r)
+		{
+			const double kHalfPi1 = 1.57079632673412561417e+00;
+			const double kHalfPi2 = 6.07710050630396597660e-11;
+			const double kHalfPi3 = 2.02226624879595063154e-21;
+			double qf = x * fastmath::kTwoOverPi;
+			int64_t q = (int64_t)(qf < 0.0 ? qf - 0.5 : qf + 0.5);
+			r = ((x - q * kHalfPi1) - q * kHalfPi2) - q * kHalfPi3;
+			return (int)(q & 3);
+		}
+
+		/** --- Taylor series to r^25 / r^24, below half an ulp for |r| <= pi/4 */
+		static constexpr double sinSeries(double r)
+		{
+			double r2 = r * r;
+			double sum = 1.0;
+			for (int n = 24; n > 0; n -= 2)
+				sum = 1.0 - sum * r2 / ((n + 1.0) * n);
+			return r * sum;
+		}
+
+		static constexpr double cosSeries(double r)
+		{
+			double r2 = r * r;
+			double sum = 1.0;
+			for (int n = 24; n > 0; n -= 2)
+				sum = 1.0 - sum * r2 / (n * (n - 1.0));
+			return sum;
+		}
+	};
+
+	/**
+	@designAudioFilter
+	\ingroup FX-Functions
+
+	@brief the design equations for one algorithm, selected at compile time; writes { a0, a1, a2, b1, b2, c0, d0 }
+
+	\param parameters - fc, Q, boost/cut and the kMMALPF2D/Regalia-Mitra extras; parameters.algorithm is ignored
+	\param sampleRate - sample rate
+	\param coeffArray - numCoeffs long, receives the coefficients
+	\return true (every filterAlgorithm has a design)
+	*/
+	template <filterAlgorithm algorithm, typename Math = ConstexprDesignMath>
+	constexpr bool designAudioFilter(const AudioFilterParameters& parameters, double sampleRate, double* coeffArray)
+	{
+		// --- clear coeff array
+		for (uint32_t i = 0; i < numCoeffs; i++)
+			coeffArray[i] = 0.0;
+
+		// --- set default pass-through
+		coeffArray[a0] = 1.0;
+		coeffArray[c0] = 1.0;
+		coeffArray[d0] = 0.0;
+
+		// --- grab these variables, to make calculations look more like the book
+		[[maybe_unused]] double fc = parameters.fc;
+		[[maybe_unused]] double Q = parameters.Q;
+		[[maybe_unused]] double boostCut_dB = parameters.boostCut_dB;
+
+		// --- decode filter type and calculate accordingly
+		// --- impulse invariabt LPF, matches closely with one-pole version,
+		//     but diverges at VHF
+		if constexpr (algorithm == filterAlgorithm::kImpInvLP1)
+		{
+			double T = 1.0 / sampleRate;
+			double omega = 2.0 * kPi * fc;
+			double eT = Math::exp(-T * omega);
+
+			coeffArray[a0] = 1.0 - eT; // <--- normalized by 1-e^aT
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = -eT;
+			coeffArray[b2] = 0.0;
+
+			// --- we updated
+			return true;
+
+		}
+		else if constexpr (algorithm == filterAlgorithm::kImpInvLP2)
+		{
+			double alpha = 2.0 * kPi * fc / sampleRate;
+			double p_Re = -alpha / (2.0 * Q);
+			double zeta = 1.0 / (2.0 * Q);
+			double p_Im = alpha * Math::sqrt((1.0 - (zeta * zeta)));
+			double c_Re = 0.0;
+			double c_Im = alpha / (2.0 * Math::sqrt((1.0 - (zeta * zeta))));
+
+			// --- each transcendental once: the fast tiers may not be inlined here, so the compiler can't merge repeats
+			double eP_re = Math::exp(p_Re);
+			double cosP_Im = Math::cos(p_Im);
+			coeffArray[a0] = c_Re;
+			coeffArray[a1] = -2.0 * (c_Re * cosP_Im + c_Im * Math::sin(p_Im)) * eP_re;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = -2.0 * eP_re * cosP_Im;
+			coeffArray[b2] = eP_re * eP_re;
+
+			// --- we updated
+			return true;
+		}
+		// --- kMatchLP2A = TIGHT fit LPF vicanek algo
+		else if constexpr (algorithm == filterAlgorithm::kMatchLP2A)
+		{
+			// http://vicanek.de/articles/BiquadFits.pdf
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+
+			double q = 1.0 / (2.0 * Q);
+
+			// --- impulse invariant
+			double b_1 = 0.0;
+			double b_2 = Math::exp(-2.0 * q * theta_c);
+			if (q <= 1.0)
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cos(Math::sqrt((1.0 - q * q)) * theta_c);
+			}
+			else
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cosh(Math::sqrt((q * q - 1.0)) * theta_c);
+			}
+
+			// --- TIGHT FIT --- //
+			double B0 = (1.0 + b_1 + b_2) * (1.0 + b_1 + b_2);
+			double B1 = (1.0 - b_1 + b_2) * (1.0 - b_1 + b_2);
+			double B2 = -4.0 * b_2;
+
+			double sinHalfTheta = Math::sin(theta_c / 2.0);
+			double phi_0 = 1.0 - sinHalfTheta * sinHalfTheta;
+			double phi_1 = sinHalfTheta * sinHalfTheta;
+			double phi_2 = 4.0 * phi_0 * phi_1;
+
+			double R1 = (B0 * phi_0 + B1 * phi_1 + B2 * phi_2) * (Q * Q);
+			double A0 = B0;
+			double A1 = (R1 - A0 * phi_0) / phi_1;
+
+			if (A0 < 0.0)
+				A0 = 0.0;
+			if (A1 < 0.0)
+				A1 = 0.0;
+
+			double a_0 = 0.5 * (Math::sqrt(A0) + Math::sqrt(A1));
+			double a_1 = Math::sqrt(A0) - a_0;
+			double a_2 = 0.0;
+
+			coeffArray[a0] = a_0;
+			coeffArray[a1] = a_1;
+			coeffArray[a2] = a_2;
+			coeffArray[b1] = b_1;
+			coeffArray[b2] = b_2;
+
+			// --- we updated
+			return true;
+		}
+		// --- kMatchLP2B = LOOSE fit LPF vicanek algo
+		else if constexpr (algorithm == filterAlgorithm::kMatchLP2B)
+		{
+			// http://vicanek.de/articles/BiquadFits.pdf
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double q = 1.0 / (2.0 * Q);
+
+			// --- impulse invariant
+			double b_1 = 0.0;
+			double b_2 = Math::exp(-2.0 * q * theta_c);
+			if (q <= 1.0)
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cos(Math::sqrt((1.0 - q * q)) * theta_c);
+			}
+			else
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cosh(Math::sqrt((q * q - 1.0)) * theta_c);
+			}
+
+			// --- LOOSE FIT --- //
+			double f0 = theta_c / kPi; // note f0 = fraction of pi, so that f0 = 1.0 = pi = Nyquist
+
+			double r0 = 1.0 + b_1 + b_2;
+			double denom = (1.0 - f0 * f0) * (1.0 - f0 * f0) + (f0 * f0) / (Q * Q);
+			denom = Math::sqrt(denom);
+			double r1 = ((1.0 - b_1 + b_2) * f0 * f0) / (denom);
+
+			double a_0 = (r0 + r1) / 2.0;
+			double a_1 = r0 - a_0;
+			double a_2 = 0.0;
+
+			coeffArray[a0] = a_0;
+			coeffArray[a1] = a_1;
+			coeffArray[a2] = a_2;
+			coeffArray[b1] = b_1;
+			coeffArray[b2] = b_2;
+
+			// --- we updated
+			return true;
+		}
+		// --- kMatchBP2A = TIGHT fit BPF vicanek algo
+		else if constexpr (algorithm == filterAlgorithm::kMatchBP2A)
+		{
+			// http://vicanek.de/articles/BiquadFits.pdf
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double q = 1.0 / (2.0 * Q);
+
+			// --- impulse invariant
+			double b_1 = 0.0;
+			double b_2 = Math::exp(-2.0 * q * theta_c);
+			if (q <= 1.0)
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cos(Math::sqrt((1.0 - q * q)) * theta_c);
+			}
+			else
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cosh(Math::sqrt((q * q - 1.0)) * theta_c);
+			}
+
+			// --- TIGHT FIT --- //
+			double B0 = (1.0 + b_1 + b_2) * (1.0 + b_1 + b_2);
+			double B1 = (1.0 - b_1 + b_2) * (1.0 - b_1 + b_2);
+			double B2 = -4.0 * b_2;
+
+			double sinHalfTheta = Math::sin(theta_c / 2.0);
+			double phi_0 = 1.0 - sinHalfTheta * sinHalfTheta;
+			double phi_1 = sinHalfTheta * sinHalfTheta;
+			double phi_2 = 4.0 * phi_0 * phi_1;
+
+			double R1 = B0 * phi_0 + B1 * phi_1 + B2 * phi_2;
+			double R2 = -B0 + B1 + 4.0 * (phi_0 - phi_1) * B2;
+
+			double A2 = (R1 - R2 * phi_1) / (4.0 * phi_1 * phi_1);
+			double A1 = R2 + 4.0 * (phi_1 - phi_0) * A2;
+
+			double a_1 = -0.5 * (Math::sqrt(A1));
+			double a_0 = 0.5 * (Math::sqrt((A2 + (a_1 * a_1))) - a_1);
+			double a_2 = -a_0 - a_1;
+
+			coeffArray[a0] = a_0;
+			coeffArray[a1] = a_1;
+			coeffArray[a2] = a_2;
+			coeffArray[b1] = b_1;
+			coeffArray[b2] = b_2;
+
+			// --- we updated
+			return true;
+		}
+		// --- kMatchBP2B = LOOSE fit BPF vicanek algo
+		else if constexpr (algorithm == filterAlgorithm::kMatchBP2B)
+		{
+			// http://vicanek.de/articles/BiquadFits.pdf
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double q = 1.0 / (2.0 * Q);
+
+			// --- impulse invariant
+			double b_1 = 0.0;
+			double b_2 = Math::exp(-2.0 * q * theta_c);
+			if (q <= 1.0)
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cos(Math::sqrt((1.0 - q * q)) * theta_c);
+			}
+			else
+			{
+				b_1 = -2.0 * Math::exp(-q * theta_c) * Math::cosh(Math::sqrt((q * q - 1.0)) * theta_c);
+			}
+
+			// --- LOOSE FIT --- //
+			double f0 = theta_c / kPi; // note f0 = fraction of pi, so that f0 = 1.0 = pi = Nyquist
+
+			double r0 = (1.0 + b_1 + b_2) / (kPi * f0 * Q);
+			double denom = (1.0 - f0 * f0) * (1.0 - f0 * f0) + (f0 * f0) / (Q * Q);
+			denom = Math::sqrt(denom);
+
+			double r1 = ((1.0 - b_1 + b_2) * (f0 / Q)) / (denom);
+
+			double a_1 = -r1 / 2.0;
+			double a_0 = (r0 - a_1) / 2.0;
+			double a_2 = -a_0 - a_1;
+
+			coeffArray[a0] = a_0;
+			coeffArray[a1] = a_1;
+			coeffArray[a2] = a_2;
+			coeffArray[b1] = b_1;
+			coeffArray[b2] = b_2;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kLPF1P)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double gamma = 2.0 - Math::cos(theta_c);
+
+			double filter_b1 = Math::sqrt((gamma * gamma - 1.0)) - gamma;
+			double filter_a0 = 1.0 + filter_b1;
+
+			// --- update coeffs
+			coeffArray[a0] = filter_a0;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = filter_b1;
+			coeffArray[b2] = 0.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kLPF1)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double gamma = Math::cos(theta_c) / (1.0 + Math::sin(theta_c));
+
+			// --- update coeffs
+			coeffArray[a0] = (1.0 - gamma) / 2.0;
+			coeffArray[a1] = (1.0 - gamma) / 2.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = -gamma;
+			coeffArray[b2] = 0.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kHPF1)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double gamma = Math::cos(theta_c) / (1.0 + Math::sin(theta_c));
+
+			// --- update coeffs
+			coeffArray[a0] = (1.0 + gamma) / 2.0;
+			coeffArray[a1] = -(1.0 + gamma) / 2.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = -gamma;
+			coeffArray[b2] = 0.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kLPF2)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double d = 1.0 / Q;
+			double sinTheta = Math::sin(theta_c);
+			double betaNumerator = 1.0 - ((d / 2.0) * sinTheta);
+			double betaDenominator = 1.0 + ((d / 2.0) * sinTheta);
+
+			double beta = 0.5 * (betaNumerator / betaDenominator);
+			double gamma = (0.5 + beta) * (Math::cos(theta_c));
+			double alpha = (0.5 + beta - gamma) / 2.0;
+
+			// --- update coeffs
+			coeffArray[a0] = alpha;
+			coeffArray[a1] = 2.0 * alpha;
+			coeffArray[a2] = alpha;
+			coeffArray[b1] = -2.0 * gamma;
+			coeffArray[b2] = 2.0 * beta;
+
+			//	double mag = getMagResponse(theta_c, coeffArray[a0], coeffArray[a1], coeffArray[a2], coeffArray[b1], coeffArray[b2]);
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kHPF2)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double d = 1.0 / Q;
+
+			double sinTheta = Math::sin(theta_c);
+			double betaNumerator = 1.0 - ((d / 2.0) * sinTheta);
+			double betaDenominator = 1.0 + ((d / 2.0) * sinTheta);
+
+			double beta = 0.5 * (betaNumerator / betaDenominator);
+			double gamma = (0.5 + beta) * (Math::cos(theta_c));
+			double alpha = (0.5 + beta + gamma) / 2.0;
+
+			// --- update coeffs
+			coeffArray[a0] = alpha;
+			coeffArray[a1] = -2.0 * alpha;
+			coeffArray[a2] = alpha;
+			coeffArray[b1] = -2.0 * gamma;
+			coeffArray[b2] = 2.0 * beta;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kBPF2)
+		{
+			// --- see book for formulae
+			double K = Math::tan(kPi * fc / sampleRate);
+			double delta = K * K * Q + K + Q;
+
+			// --- update coeffs
+			coeffArray[a0] = K / delta;;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = -K / delta;
+			coeffArray[b1] = 2.0 * Q * (K * K - 1) / delta;
+			coeffArray[b2] = (K * K * Q - K + Q) / delta;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kBPF2Boost)
+		{
+			// Homework BPF:
+			// add Boost and relate it to Q, more Boost, more Q
+			// --- see book for formulae
+			double K = Math::tan(kPi * fc / sampleRate);
+
+			double mu = Math::pow10(boostCut_dB / 20.0);
+
+			double delta = K * K * Q + K + Q;
+
+			// --- update coeffs
+			coeffArray[a0] = (K / delta) * mu;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = (- K / delta)* mu;
+			coeffArray[b1] = 2.0 * Q * (K * K - 1) / delta;
+			coeffArray[b2] = (K * K * Q - K + Q) / delta;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kBSF2)
+		{
+			// --- see book for formulae
+			double K = Math::tan(kPi * fc / sampleRate);
+			double delta = K * K * Q + K + Q;
+
+			// --- update coeffs
+			coeffArray[a0] = Q * (1 + K * K) / delta;
+			coeffArray[a1] = 2.0 * Q * (K * K - 1) / delta;
+			coeffArray[a2] = Q * (1 + K * K) / delta;
+			coeffArray[b1] = 2.0 * Q * (K * K - 1) / delta;
+			coeffArray[b2] = (K * K * Q - K + Q) / delta;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kButterLPF2)
+		{
+			// --- see book for formulae
+			double theta_c = kPi * fc / sampleRate;
+			double C = 1.0 / Math::tan(theta_c);
+
+			// --- update coeffs
+			coeffArray[a0] = 1.0 / (1.0 + kSqrtTwo * C + C * C);
+			coeffArray[a1] = 2.0 * coeffArray[a0];
+			coeffArray[a2] = coeffArray[a0];
+			coeffArray[b1] = 2.0 * coeffArray[a0] * (1.0 - C * C);
+			coeffArray[b2] = coeffArray[a0] * (1.0 - kSqrtTwo * C + C * C);
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kButterHPF2)
+		{
+			// --- see book for formulae
+			double theta_c = kPi * fc / sampleRate;
+			double C = Math::tan(theta_c);
+
+			// --- update coeffs
+			coeffArray[a0] = 1.0 / (1.0 + kSqrtTwo * C + C * C);
+			coeffArray[a1] = -2.0 * coeffArray[a0];
+			coeffArray[a2] = coeffArray[a0];
+			coeffArray[b1] = 2.0 * coeffArray[a0] * (C * C - 1.0);
+			coeffArray[b2] = coeffArray[a0] * (1.0 - kSqrtTwo * C + C * C);
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kButterBPF2)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double BW = fc / Q;
+			double delta_c = kPi * BW / sampleRate;
+			if (delta_c >= 0.95 * kPi / 2.0) delta_c = 0.95 * kPi / 2.0;
+
+			double C = 1.0 / Math::tan(delta_c);
+			double D = 2.0 * Math::cos(theta_c);
+
+			// --- update coeffs
+			coeffArray[a0] = 1.0 / (1.0 + C);
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = -coeffArray[a0];
+			coeffArray[b1] = -coeffArray[a0] * (C * D);
+			coeffArray[b2] = coeffArray[a0] * (C - 1.0);
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kButterBSF2)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double BW = fc / Q;
+			double delta_c = kPi * BW / sampleRate;
+			if (delta_c >= 0.95 * kPi / 2.0) delta_c = 0.95 * kPi / 2.0;
+
+			double C = Math::tan(delta_c);
+			double D = 2.0 * Math::cos(theta_c);
+
+			// --- update coeffs
+			coeffArray[a0] = 1.0 / (1.0 + C);
+			coeffArray[a1] = -coeffArray[a0] * D;
+			coeffArray[a2] = coeffArray[a0];
+			coeffArray[b1] = -coeffArray[a0] * D;
+			coeffArray[b2] = coeffArray[a0] * (1.0 - C);
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kMMALPF2A || algorithm == filterAlgorithm::kMMALPF2B || algorithm == filterAlgorithm::kMMALPF2C || algorithm == filterAlgorithm::kMMALPF2D)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double resonance_dB = 0;
+
+			if (Q > 0.707)
+			{
+				double peak = Q * Q / Math::sqrt(Q * Q - 0.25);
+				resonance_dB = 20.0 * Math::log10(peak);
+			}
+
+			// --- intermediate vars
+			double resonance = (Math::cos(theta_c) + (Math::sin(theta_c) * Math::sqrt(Math::pow10((resonance_dB / 10.0)) - 1))) / ((Math::pow10((resonance_dB / 20.0)) * Math::sin(theta_c)) + 1);
+
+			double g = 1.0;
+
+			// gain reduction by 0.5 of resonant peak in dB
+			if(algorithm == filterAlgorithm::kMMALPF2A)
+				g = Math::pow10((-resonance_dB / 40.0));
+		
+			// gain reduction by 0.25 of resonant peak in dB
+			else if(algorithm == filterAlgorithm::kMMALPF2B)
+				g = Math::pow10((-resonance_dB / 20.0));
+
+			// --- kMMALPF2C disables the GR with increase in Q
+			else if (algorithm == filterAlgorithm::kMMALPF2C)
+				g = 1.0;
+		
+			// 
+			else if (algorithm == filterAlgorithm::kMMALPF2D)
+			{
+				g = Math::pow10((-resonance_dB / kMMAGainReduction[parameters.gr_index]));
+			}
+			
+
+			double filter_b1 = (-2.0) * resonance * Math::cos(theta_c);
+			double filter_b2 = resonance * resonance;
+			double filter_a0 = g * (1 + filter_b1 + filter_b2);
+
+			// --- update coeffs
+			coeffArray[a0] = filter_a0;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = filter_b1;
+			coeffArray[b2] = filter_b2;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kLowShelf)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double mu = Math::pow10(boostCut_dB / 20.0);
+
+			double beta = 4.0 / (1.0 + mu);
+			double delta = beta * Math::tan(theta_c / 2.0);
+			double gamma = (1.0 - delta) / (1.0 + delta);
+
+			// --- update coeffs
+			coeffArray[a0] = (1.0 - gamma) / 2.0;
+			coeffArray[a1] = (1.0 - gamma) / 2.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = -gamma;
+			coeffArray[b2] = 0.0;
+
+			coeffArray[c0] = mu - 1.0;
+			coeffArray[d0] = 1.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kHiShelf)
+		{
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double mu = Math::pow10(boostCut_dB / 20.0);
+
+			double beta = (1.0 + mu) / 4.0;
+			double delta = beta * Math::tan(theta_c / 2.0);
+			double gamma = (1.0 - delta) / (1.0 + delta);
+
+			coeffArray[a0] = (1.0 + gamma) / 2.0;
+			coeffArray[a1] = -coeffArray[a0];
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = -gamma;
+			coeffArray[b2] = 0.0;
+
+			coeffArray[c0] = mu - 1.0;
+			coeffArray[d0] = 1.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kCQParaEQ)
+		{
+			// --- see book for formulae
+			double K = Math::tan(kPi * fc / sampleRate);
+			double Vo = Math::pow10(boostCut_dB / 20.0);
+			bool bBoost = boostCut_dB >= 0 ? true : false;
+
+			double d0 = 1.0 + (1.0 / Q) * K + K * K;
+			double e0 = 1.0 + (1.0 / (Vo * Q)) * K + K * K;
+			double alpha = 1.0 + (Vo / Q) * K + K * K;
+			double beta = 2.0 * (K * K - 1.0);
+			double gamma = 1.0 - (Vo / Q) * K + K * K;
+			double delta = 1.0 - (1.0 / Q) * K + K * K;
+			double eta = 1.0 - (1.0 / (Vo * Q)) * K + K * K;
+
+			// --- update coeffs
+			coeffArray[a0] = bBoost ? alpha / d0 : d0 / e0;
+			coeffArray[a1] = bBoost ? beta / d0 : beta / e0;
+			coeffArray[a2] = bBoost ? gamma / d0 : delta / e0;
+			coeffArray[b1] = bBoost ? beta / d0 : beta / e0;
+			coeffArray[b2] = bBoost ? delta / d0 : eta / e0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kNCQParaEQ)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double mu = Math::pow10(boostCut_dB / 20.0);
+
+			// --- clamp to 0.95 pi/2 (you can experiment with this)
+			double tanArg = theta_c / (2.0 * Q);
+			if (tanArg >= 0.95 * kPi / 2.0) tanArg = 0.95 * kPi / 2.0;
+
+			// --- intermediate variables (you can condense this if you wish)
+			double zeta = 4.0 / (1.0 + mu);
+			double betaNumerator = 1.0 - zeta * Math::tan(tanArg);
+			double betaDenominator = 1.0 + zeta * Math::tan(tanArg);
+
+			double beta = 0.5 * (betaNumerator / betaDenominator);
+			double gamma = (0.5 + beta) * (Math::cos(theta_c));
+			double alpha = (0.5 - beta);
+
+			// --- update coeffs
+			coeffArray[a0] = alpha;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = -alpha;
+			coeffArray[b1] = -2.0 * gamma;
+			coeffArray[b2] = 2.0 * beta;
+
+			coeffArray[c0] = mu - 1.0;
+			coeffArray[d0] = 1.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kLWRLPF2)
+		{
+			// --- see book for formulae
+			double omega_c = kPi * fc;
+			double theta_c = kPi * fc / sampleRate;
+
+			double k = omega_c / Math::tan(theta_c);
+			double denominator = k * k + omega_c * omega_c + 2.0 * k * omega_c;
+			double b1_Num = -2.0 * k * k + 2.0 * omega_c * omega_c;
+			double b2_Num = -2.0 * k * omega_c + k * k + omega_c * omega_c;
+
+			// --- update coeffs
+			coeffArray[a0] = omega_c * omega_c / denominator;
+			coeffArray[a1] = 2.0 * omega_c * omega_c / denominator;
+			coeffArray[a2] = coeffArray[a0];
+			coeffArray[b1] = b1_Num / denominator;
+			coeffArray[b2] = b2_Num / denominator;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kLWRHPF2)
+		{
+			// --- see book for formulae
+			double omega_c = kPi * fc;
+			double theta_c = kPi * fc / sampleRate;
+
+			double k = omega_c / Math::tan(theta_c);
+			double denominator = k * k + omega_c * omega_c + 2.0 * k * omega_c;
+			double b1_Num = -2.0 * k * k + 2.0 * omega_c * omega_c;
+			double b2_Num = -2.0 * k * omega_c + k * k + omega_c * omega_c;
+
+			// --- update coeffs
+			coeffArray[a0] = k * k / denominator;
+			coeffArray[a1] = -2.0 * k * k / denominator;
+			coeffArray[a2] = coeffArray[a0];
+			coeffArray[b1] = b1_Num / denominator;
+			coeffArray[b2] = b2_Num / denominator;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kAPF1)
+		{
+			// --- see book for formulae
+			double alphaNumerator = Math::tan((kPi * fc) / sampleRate) - 1.0;
+			double alphaDenominator = Math::tan((kPi * fc) / sampleRate) + 1.0;
+			double alpha = alphaNumerator / alphaDenominator;
+
+			// --- update coeffs
+			coeffArray[a0] = alpha;
+			coeffArray[a1] = 1.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = alpha;
+			coeffArray[b2] = 0.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kAPF2)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double BW = fc / Q;
+			double argTan = kPi * BW / sampleRate;
+			if (argTan >= 0.95 * kPi / 2.0) argTan = 0.95 * kPi / 2.0;
+
+			double alphaNumerator = Math::tan(argTan) - 1.0;
+			double alphaDenominator = Math::tan(argTan) + 1.0;
+			double alpha = alphaNumerator / alphaDenominator;
+			double beta = -Math::cos(theta_c);
+
+			// --- update coeffs
+			coeffArray[a0] = -alpha;
+			coeffArray[a1] = beta * (1.0 - alpha);
+			coeffArray[a2] = 1.0;
+			coeffArray[b1] = beta * (1.0 - alpha);
+			coeffArray[b2] = -alpha;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kRM1)
+		{
+			// Homework 1st Order Regalia Mitra Filter
+			// --- see book for formulae
+			double alphaNumerator = Math::tan((kPi * fc) / sampleRate) - 1.0;
+			double alphaDenominator = Math::tan((kPi * fc) / sampleRate) + 1.0;
+			double alpha = alphaNumerator / alphaDenominator;
+			double K = parameters.k;
+
+			// --- update coeffs
+			coeffArray[a0] = 0.5 * (1 + K + alpha - (K * alpha));
+			coeffArray[a1] = 0.5 * (1 - K + alpha + (K * alpha));
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = alpha;
+			coeffArray[b2] = 0.0;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kRM2)
+		{
+			// Homework 2nd Order Regalia Mitra Filter
+			// --- see book for formulae
+			double theta_c = kPi * fc / sampleRate;
+			double BW = fc / Q;
+			double argTan = kPi * BW / sampleRate;
+			if (argTan >= 0.95 * kPi / 2.0) argTan = 0.95 * kPi / 2.0;
+
+			double alphaNumerator = Math::tan(argTan) - 1.0;
+			double alphaDenominator = Math::tan(argTan) + 1.0;
+			double alpha = alphaNumerator / alphaDenominator;
+			double beta = -Math::cos(theta_c);
+			double K = parameters.k;
+
+			// --- update coeffs
+			coeffArray[a0] = 0.5 * (1 - alpha + K + (alpha * K));
+			coeffArray[a1] = beta * (1 - alpha);
+			coeffArray[a2] = 0.5 * (1 - alpha - K - (K * alpha));
+			coeffArray[b1] = beta * (1.0 - alpha);
+			coeffArray[b2] = -alpha;
+
+			// --- we updated
+			return true;
+			}
+		else if constexpr (algorithm == filterAlgorithm::kResonA)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double BW = fc / Q;
+			double filter_b2 = Math::exp(-2.0 * kPi * (BW / sampleRate));
+			double filter_b1 = ((-4.0 * filter_b2) / (1.0 + filter_b2)) * Math::cos(theta_c);
+			double filter_a0 = (1.0 - filter_b2) * Math::sqrt((1.0 - (filter_b1 * filter_b1) / (4.0 * filter_b2)));
+
+			// --- update coeffs
+			coeffArray[a0] = filter_a0;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = 0.0;
+			coeffArray[b1] = filter_b1;
+			coeffArray[b2] = filter_b2;
+
+			// --- we updated
+			return true;
+		}
+		else if constexpr (algorithm == filterAlgorithm::kResonB)
+		{
+			// --- see book for formulae
+			double theta_c = 2.0 * kPi * fc / sampleRate;
+			double BW = fc / Q;
+			double filter_b2 = Math::exp(-2.0 * kPi * (BW / sampleRate));
+			double filter_b1 = ((-4.0 * filter_b2) / (1.0 + filter_b2)) * Math::cos(theta_c);
+			double filter_a0 = 1.0 - Math::sqrt(filter_b2); // (1.0 - filter_b2)*pow((1.0 - (filter_b1*filter_b1) / (4.0 * filter_b2)), 0.5);
+
+			// --- update coeffs
+			coeffArray[a0] = filter_a0;
+			coeffArray[a1] = 0.0;
+			coeffArray[a2] = -filter_a0;
+			coeffArray[b1] = filter_b1;
+			coeffArray[b2] = filter_b2;
+
+			// --- we updated
+			return true;
+		}
+
+
+		// --- we did n't update :(
+		return false;
+	}
+
+	/**
+	@designAudioFilter
+	\ingroup FX-Functions
+
+	@brief the design equations for parameters.algorithm, decoded at run time; algorithms that are not decoded
+	get the pass-through array { 1, 0, 0, 0, 0, 1, 0 }
+
+	\param parameters - filter parameters
+	\param sampleRate - sample rate
+	\param coeffArray - numCoeffs long, receives the coefficients
+	\return true if the algorithm was decoded
+	*/
+	template <typename Math>
+	constexpr bool designAudioFilter(const AudioFilterParameters& parameters, double sampleRate, double* coeffArray)
+	{
+		switch (parameters.algorithm)
+		{
+		case filterAlgorithm::kLPF1P: return designAudioFilter<filterAlgorithm::kLPF1P, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kLPF1: return designAudioFilter<filterAlgorithm::kLPF1, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kHPF1: return designAudioFilter<filterAlgorithm::kHPF1, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kLPF2: return designAudioFilter<filterAlgorithm::kLPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kHPF2: return designAudioFilter<filterAlgorithm::kHPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kBPF2: return designAudioFilter<filterAlgorithm::kBPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kBPF2Boost: return designAudioFilter<filterAlgorithm::kBPF2Boost, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kBSF2: return designAudioFilter<filterAlgorithm::kBSF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kButterLPF2: return designAudioFilter<filterAlgorithm::kButterLPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kButterHPF2: return designAudioFilter<filterAlgorithm::kButterHPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kButterBPF2: return designAudioFilter<filterAlgorithm::kButterBPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kButterBSF2: return designAudioFilter<filterAlgorithm::kButterBSF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMMALPF2A: return designAudioFilter<filterAlgorithm::kMMALPF2A, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMMALPF2B: return designAudioFilter<filterAlgorithm::kMMALPF2B, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMMALPF2C: return designAudioFilter<filterAlgorithm::kMMALPF2C, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMMALPF2D: return designAudioFilter<filterAlgorithm::kMMALPF2D, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kLowShelf: return designAudioFilter<filterAlgorithm::kLowShelf, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kHiShelf: return designAudioFilter<filterAlgorithm::kHiShelf, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kNCQParaEQ: return designAudioFilter<filterAlgorithm::kNCQParaEQ, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kCQParaEQ: return designAudioFilter<filterAlgorithm::kCQParaEQ, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kLWRLPF2: return designAudioFilter<filterAlgorithm::kLWRLPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kLWRHPF2: return designAudioFilter<filterAlgorithm::kLWRHPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kAPF1: return designAudioFilter<filterAlgorithm::kAPF1, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kAPF2: return designAudioFilter<filterAlgorithm::kAPF2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kRM1: return designAudioFilter<filterAlgorithm::kRM1, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kRM2: return designAudioFilter<filterAlgorithm::kRM2, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kResonA: return designAudioFilter<filterAlgorithm::kResonA, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kResonB: return designAudioFilter<filterAlgorithm::kResonB, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMatchLP2A: return designAudioFilter<filterAlgorithm::kMatchLP2A, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMatchLP2B: return designAudioFilter<filterAlgorithm::kMatchLP2B, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMatchBP2A: return designAudioFilter<filterAlgorithm::kMatchBP2A, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kMatchBP2B: return designAudioFilter<filterAlgorithm::kMatchBP2B, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kImpInvLP1: return designAudioFilter<filterAlgorithm::kImpInvLP1, Math>(parameters, sampleRate, coeffArray);
+		case filterAlgorithm::kImpInvLP2: return designAudioFilter<filterAlgorithm::kImpInvLP2, Math>(parameters, sampleRate, coeffArray);
+		default:
+			break;
+		}
+
+		// --- pass-through
+		for (uint32_t i = 0; i < numCoeffs; i++)
+			coeffArray[i] = 0.0;
+		coeffArray[a0] = 1.0;
+		coeffArray[c0] = 1.0;
+		return false;
+	}
+
+	/**
+	@bakeAudioFilterCoeffs
+	\ingroup FX-Functions
+
+	@brief the coefficient array for a parameter set and sample rate, computed with ConstexprDesignMath so that it
+	can initialize a constexpr array, e.g.
+
+		constexpr auto dcBlocker = bakeAudioFilterCoeffs<filterAlgorithm::kHPF1>(5.0, 0.707, 48000.0);
+
+	\param fc - cutoff or center frequency (Hz)
+	\param Q - filter Q
+	\param sampleRate - sample rate
+	\param boostCut_dB - gain for the shelving, para EQ and kBPF2Boost designs
+	\return { a0, a1, a2, b1, b2, c0, d0 }
+	*/
+	template <filterAlgorithm algorithm>
+	constexpr std::array<double, numCoeffs> bakeAudioFilterCoeffs(double fc, double Q, double sampleRate, double boostCut_dB = 0.0)
+	{
+		AudioFilterParameters parameters;
+		parameters.algorithm = algorithm;
+		parameters.fc = fc;
+		parameters.Q = Q;
+		parameters.boostCut_dB = boostCut_dB;
+
+		std::array<double, numCoeffs> coeffs = {};
+		designAudioFilter<algorithm, ConstexprDesignMath>(parameters, sampleRate, coeffs.data());
+		return coeffs;
+	}
+
+	/**
+	@bakeAudioFilterCoeffs
+	\ingroup FX-Functions
+
+	@brief as above for a complete parameter set (gr_index, k), with the algorithm decoded from parameters
+
+	\param parameters - filter parameters
+	\param sampleRate - sample rate
+	\return { a0, a1, a2, b1, b2, c0, d0 }
+	*/
+	constexpr std::array<double, numCoeffs> bakeAudioFilterCoeffs(const AudioFilterParameters& parameters, double sampleRate)
+	{
+		std::array<double, numCoeffs> coeffs = {};
+		designAudioFilter<ConstexprDesignMath>(parameters, sampleRate, coeffs.data());
+		return coeffs;
+	}
+} // namespace fxobjects
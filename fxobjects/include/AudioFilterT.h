@@ -0,0 +1,231 @@
+/**
+\class AudioFilterT
+\ingroup FX-Objects
+\brief
+An AudioFilter with the algorithm fixed at compile time: the design is designAudioFilter<algorithm>( )
+(AudioFilterDesign.h) called directly instead of through the 34-way runtime decode, and the process kernel
+is chosen for the algorithm:
+
+- first order designs (kLPF1P, kLPF1, kHPF1, kAPF1, kRM1, kImpInvLP1, the shelves) run FirstOrderKernel,
+  which has no a2/b2 terms and one state
+- only the shelves and kNCQParaEQ pay the (dry) + (processed) = x(n)*d0 + y(n)*c0 mix; everything else
+  returns the biquad output directly
+
+The output is bit-identical to an AudioFilter with the same parameters, math tier and SampleType. Use AudioFilter
+where the algorithm is a user choice; it stays the runtime-selectable filter and dispatches to the same
+per-algorithm designs. AudioFilterT has no coefficient tables or coefficient ramps. As in AudioFilter, the
+setters only record the change and the design runs once, before the next sample or block is processed.
+
+	AudioFilterT<filterAlgorithm::kButterLPF2> antiAlias;
+
+	antiAlias.reset(sampleRate);
+	AudioFilterParameters params = antiAlias.getParameters();
+	params.fc = 18000.0;
+	antiAlias.setParameters(params);
+*/
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include "IAudioSignalProcessor.h"
+#include "EnumsAndStructs.h"
+#include "BiquadKernels.h"
+#include "FastMath.h"
+#include "AudioFilterDesign.h"
+#include "FrequencyResponse.h"
+
+namespace fxobjects
+{
+	template <filterAlgorithm algorithm, typename SampleType = double>
+	class AudioFilterT : public IAudioSignalProcessor
+	{
+	public:
+		AudioFilterT()		/* C-TOR */
+		{
+			audioFilterParameters.algorithm = algorithm;
+		}
+		~AudioFilterT() {}	/* D-TOR */
+
+		/** --- the design has a2 = b2 = 0 */
+		static constexpr bool firstOrder = isFirstOrderAlgorithm(algorithm);
+
+		/** --- the design sets c0/d0 */
+		static constexpr bool dryWetMix = usesDryWetMix(algorithm);
+
+		// --- IAudioSignalProcessor
+		/** --- flush the state; the design follows the new sample rate */
+		virtual bool reset(double _sampleRate)
+		{
+			memset(&stateArray[0], 0, sizeof(SampleType) * numStates);
+
+			sampleRate = _sampleRate;
+			coeffsDirty = true;
+			return true;
+		}
+
+		/** return false: this object only processes samples */
+		virtual bool canProcessAudioFrame() { return false; }
+
+		/** process input x(n) through the filter to produce return value y(n) */
+		virtual double processAudioSample(double xn)
+		{
+			updateCoefficients();
+			SampleType yn = Kernel::processSample(kernelCoeffs, stateArray, (SampleType)xn);
+
+			if constexpr (dryWetMix)
+				return kernelCoeffs[d0] * xn + kernelCoeffs[c0] * (double)yn;
+			else
+				return yn;
+		}
+
+		/** process a block through the filter */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+		/** process a block through the filter, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
+		/** --- sample rate change necessarily requires recalculation */
+		virtual void setSampleRate(double _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			coeffsDirty = true;
+		}
+
+		/** --- get parameters; algorithm is always the template argument */
+		AudioFilterParameters getParameters() { return audioFilterParameters; }
+
+		/** --- set parameters; parameters.algorithm is ignored and the design is deferred to the next update */
+		void setParameters(const AudioFilterParameters& parameters)
+		{
+			if (audioFilterParameters.boostCut_dB == parameters.boostCut_dB &&
+				audioFilterParameters.fc == parameters.fc &&
+				audioFilterParameters.Q == parameters.Q &&
+				audioFilterParameters.gr_index == parameters.gr_index &&
+				audioFilterParameters.k == parameters.k)
+				return;
+
+			// --- save new params
+			audioFilterParameters = parameters;
+			audioFilterParameters.algorithm = algorithm;
+
+			// --- don't allow 0 or (-) values for Q
+			if (audioFilterParameters.Q <= 0)
+				audioFilterParameters.Q = 0.707;
+
+			// --- flag coeffs for update
+			coeffsDirty = true;
+		}
+
+		/** --- the math tier used by the design equations, see AudioFilter::setMathAccuracy( ) */
+		/**
+		\param _accuracy the math tier for subsequent designs
+		*/
+		void setMathAccuracy(mathAccuracy _accuracy)
+		{
+			designAccuracy = _accuracy;
+
+			// --- flag coeffs for update
+			coeffsDirty = true;
+		}
+
+		/** --- the math tier used by the design equations */
+		mathAccuracy getMathAccuracy() { return designAccuracy; }
+
+		/** --- run the deferred design now, see AudioFilter::updateCoefficients( ) */
+		/**
+		\return true if the coefficients were recalculated
+		*/
+		bool updateCoefficients()
+		{
+			if (!coeffsDirty)
+				return false;
+
+			calculateFilterCoeffs();
+			return true;
+		}
+
+		/** --- get the current coefficient array { a0, a1, a2, b1, b2, c0, d0 } */
+		const double* getCoefficients()
+		{
+			updateCoefficients();
+			return &coeffArray[0];
+		}
+
+		/** --- magnitude and phase of the current design, evaluated from coeffArray rather than measured; see
+			FrequencyResponse.h */
+		/**
+		\param frequencies count frequencies in Hz
+		\param count number of frequencies
+		\param magnitude_dB receives count magnitudes in dB
+		\param phase receives count phases in radians; may be nullptr
+		*/
+		void getFrequencyResponse(const double* frequencies, uint32_t count, double* magnitude_dB, double* phase = nullptr)
+		{
+			updateCoefficients();
+			getBiquadFrequencyResponse(coeffArray, sampleRate, frequencies, count, magnitude_dB, phase);
+		}
+
+	protected:
+		// --- one-pole/one-zero or full transposed canonical biquad
+		using Kernel = typename std::conditional<firstOrder, FirstOrderKernel, BiquadKernel<biquadAlgorithm::kTransposeCanonical>>::type;
+
+		double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };		///< current design
+		SampleType kernelCoeffs[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };	///< current design in the kernel precision
+		SampleType stateArray[numStates] = { 0.0, 0.0, 0.0, 0.0 };					///< transposed canonical state
+
+		// --- object parameters
+		AudioFilterParameters audioFilterParameters; ///< parameters
+		double sampleRate = 44100.0; ///< current sample rate
+		mathAccuracy designAccuracy = mathAccuracy::kExact; ///< math tier for the design equations
+		bool coeffsDirty = true; ///< coeffArray is out of date
+
+		/** --- run this algorithm's design equations at the current math tier */
+		void calculateFilterCoeffs()
+		{
+			if (designAccuracy == mathAccuracy::kHigh)
+				designAudioFilter<algorithm, FastDesignMath<mathAccuracy::kHigh>>(audioFilterParameters, sampleRate, coeffArray);
+			else if (designAccuracy == mathAccuracy::kLow)
+				designAudioFilter<algorithm, FastDesignMath<mathAccuracy::kLow>>(audioFilterParameters, sampleRate, coeffArray);
+			else
+				designAudioFilter<algorithm, FastDesignMath<mathAccuracy::kExact>>(audioFilterParameters, sampleRate, coeffArray);
+
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				kernelCoeffs[i] = (SampleType)coeffArray[i];
+
+			coeffsDirty = false;
+		}
+
+		/** --- block worker; coefficients and state live in locals for the block */
+		template <typename BufferType>
+		void processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+		{
+			updateCoefficients();
+
+			SampleType c[numCoeffs];
+			SampleType z[numStates];
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				c[i] = kernelCoeffs[i];
+			for (uint32_t i = 0; i < numStates; i++)
+				z[i] = stateArray[i];
+
+			// --- the mix runs in double, as in AudioFilter
+			const double dry = coeffArray[d0];
+			const double wet = coeffArray[c0];
+
+			for (uint32_t i = 0; i < n; i++)
+			{
+				SampleType xn = (SampleType)in[i];
+				SampleType yn = Kernel::processSample(c, z, xn);
+
+				if constexpr (dryWetMix)
+					out[i] = (BufferType)(dry * xn + wet * yn);
+				else
+					out[i] = (BufferType)yn;
+			}
+
+			for (uint32_t i = 0; i < numStates; i++)
+				stateArray[i] = z[i];
+		}
+	};
+} // namespace fxobjects
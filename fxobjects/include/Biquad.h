@@ -3,21 +3,25 @@
 #include <cstring>
 #include "IAudioSignalProcessor.h"
 #include "EnumsAndStructs.h"
+#include "BiquadKernels.h"
 
 namespace fxobjects {
 
-	class Biquad : public IAudioSignalProcessor
+	/** Biquad with coefficients and state stored as SampleType (float or double); the
+		IAudioSignalProcessor interface stays double. Biquad is BasicBiquad<double>. */
+	template <typename SampleType = double>
+	class BasicBiquad : public IAudioSignalProcessor
 	{
 	public:
-		Biquad() {}		/* C-TOR */
-		~Biquad() {}	/* D-TOR */
+		BasicBiquad() {}		/* C-TOR */
+		~BasicBiquad() {}	/* D-TOR */
 	
 		// --- IAudioSignalProcessor FUNCTIONS --- //
 		//
 		/** reset: clear out the state array (flush delays); can safely ignore sampleRate argument - we don't need/use it */
 		virtual bool reset(double _sampleRate)
 		{
-			memset(&stateArray[0], 0, sizeof(double) * numStates);
+			memset(&stateArray[0], 0, sizeof(SampleType) * numStates);
 			return true;  // handled = true
 		}
 	
@@ -31,6 +35,17 @@ namespace fxobjects {
 		*/
 		virtual double processAudioSample(double xn);
 	
+		/** process a block of samples; the structure type is decoded once per block, not once per sample */
+		/**
+		\param in input buffer
+		\param out output buffer (may be the same as in)
+		\param n number of samples
+		*/
+		virtual void processBlock(const float* in, float* out, uint32_t n);
+	
+		/** process a block of samples, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n);
+	
 		/** get parameters: note use of custom structure for passing param data */
 		/**
 		\return BiquadParameters custom data structure
@@ -46,19 +61,54 @@ namespace fxobjects {
 		// --- MUTATORS & ACCESSORS --- //
 		/** set the coefficient array NOTE: passing by pointer to array; allows us to use "array notation" with pointers i.e. [ ] */
 		void setCoefficients(double* coeffs) {
-			// --- fast block memory copy:
-			memcpy(&coeffArray[0], &coeffs[0], sizeof(double) * numCoeffs);
+			// --- copy, converting to our sample type
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				coeffArray[i] = (SampleType)coeffs[i];
+
+			// --- a direct set cancels any ramp in progress
+			rampSamplesRemaining = 0;
 		}
+
+		/** linearly ramp the coefficient array to a new target over rampLength samples; the ramp is advanced
+			inside the block kernel, so modulation costs a few adds per sample instead of a redesign; a straight
+			line between two stable second order denominators stays inside the (convex) stability triangle */
+		/**
+		\param coeffs target coefficient array
+		\param rampLength number of samples to reach the target; 0 sets the target immediately
+		*/
+		void setCoefficientsRamped(const double* coeffs, uint32_t rampLength)
+		{
+			if (rampLength == 0)
+			{
+				for (uint32_t i = 0; i < numCoeffs; i++)
+					coeffArray[i] = (SampleType)coeffs[i];
+				rampSamplesRemaining = 0;
+				return;
+			}
+
+			for (uint32_t i = 0; i < numCoeffs; i++)
+			{
+				coeffTarget[i] = (SampleType)coeffs[i];
+				coeffIncrement[i] = (SampleType)((coeffs[i] - coeffArray[i]) / rampLength);
+			}
+			rampSamplesRemaining = rampLength;
+		}
+
+		/** number of samples left in the current coefficient ramp, 0 if not ramping */
+		uint32_t getRampSamplesRemaining() { return rampSamplesRemaining; }
+
+		/** per-sample coefficient increments of the current ramp */
+		const SampleType* getRampIncrements() { return &coeffIncrement[0]; }
 	
 		/** get the coefficient array for read/write access to the array (not used in current objects) */
-		double* getCoefficients()
+		SampleType* getCoefficients()
 		{
 			// --- read/write access to the array (not used)
 			return &coeffArray[0];
 		}
 	
 		/** get the state array for read/write access to the array (used only in direct form oscillator) */
-		double* getStateArray()
+		SampleType* getStateArray()
 		{
 			// --- read/write access to the array (used only in direct form oscillator)
 			return &stateArray[0];
@@ -72,15 +122,38 @@ namespace fxobjects {
 	
 	protected:
 		/** array of coefficients */
-		double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+		SampleType coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 	
 		/** array of state (z^-1) registers */
-		double stateArray[numStates] = { 0.0, 0.0, 0.0, 0.0 };
+		SampleType stateArray[numStates] = { 0.0, 0.0, 0.0, 0.0 };
 	
 		/** type of calculation (algorithm  structure) */
 		BiquadParameters parameters;
 	
 		/** for Harma loop resolution */
 		double storageComponent = 0.0;
+
+		/** coefficient ramp: target, per-sample increment and samples to go */
+		SampleType coeffTarget[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+		SampleType coeffIncrement[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+		uint32_t rampSamplesRemaining = 0;
+
+		/** advance the coefficient ramp by one sample; the last step lands exactly on the target */
+		void advanceRamp()
+		{
+			if (--rampSamplesRemaining == 0)
+				memcpy(&coeffArray[0], &coeffTarget[0], sizeof(SampleType) * numCoeffs);
+			else
+			{
+				for (uint32_t i = 0; i < numCoeffs; i++)
+					coeffArray[i] += coeffIncrement[i];
+			}
+		}
+	
+		/** block processing worker, shared by the float and double overrides */
+		template <typename BufferType>
+		void processBlockT(const BufferType* in, BufferType* out, uint32_t n);
 	};
+
+	using Biquad = BasicBiquad<double>;
 } // namespace fxobjects
@@ -0,0 +1,198 @@
+/**
+\class BiquadBank
+\ingroup FX-Objects
+\brief
+The BiquadBank object runs a large number of independent transposed canonical biquads that are all fed
+by the same input, e.g. a filterbank for analysis or a set of modal resonators (kResonA, kResonB, kBPF2).
+Coefficients and z^-1 registers are stored structure-of-arrays ([coefficient][filter], [register][filter])
+in contiguous memory, and each sample is run through the whole bank in one loop over the filters, so the
+compiler vectorizes across filters (4/8/16 filters per instruction for float, depending on the target).
+
+Audio I/O:
+- Processes mono input to a summed mono output (processBlockSum) or to one output buffer per filter (processBlock)
+
+Control I/F:
+- setNumFilters( ) to allocate the bank (not from the realtime thread)
+- setCoefficients( ) takes the AudioFilter/Biquad layout { a0, a1, a2, b1, b2, c0, d0 }; the dry/wet
+  mix d0 + c0*H(z) and an optional per-filter gain are folded into the numerator
+- setFilter( ) designs a filter with any AudioFilter algorithm at the bank sample rate
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include "EnumsAndStructs.h"
+#include "Constants.h"
+#include "AudioFilter.h"
+
+namespace fxobjects
+{
+	template <typename SampleType = float>
+	class BiquadBank
+	{
+	public:
+		BiquadBank() {}		/* C-TOR */
+		~BiquadBank() {}	/* D-TOR */
+
+		/** reset: clear the state registers of every filter; the sample rate is stored for setFilter( ) */
+		bool reset(double _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			for (uint32_t i = 0; i < numRegisters * stride; i++)
+				stateArray[i] = 0.0;
+			return true;
+		}
+
+		/** allocate the bank, all filters silent (zero numerator);
+			do NOT call from realtime audio thread */
+		void setNumFilters(uint32_t _numFilters)
+		{
+			numFilters = _numFilters;
+
+			// --- pad to a whole number of vector widths so the filter loops need no remainder handling
+			stride = (numFilters + kPadding - 1) / kPadding * kPadding;
+
+			coeffArray.reset(new SampleType[numBankCoeffs * stride]);
+			stateArray.reset(new SampleType[numRegisters * stride]);
+			outputRows.reset(new SampleType[kOutputChunk * stride]);
+
+			for (uint32_t i = 0; i < numBankCoeffs * stride; i++)
+				coeffArray[i] = 0.0;
+			for (uint32_t i = 0; i < numRegisters * stride; i++)
+				stateArray[i] = 0.0;
+		}
+
+		/** get the number of filters */
+		uint32_t getNumFilters() { return numFilters; }
+
+		/** load one filter from an AudioFilter style coefficient array */
+		/**
+		\param filter index of the filter
+		\param coeffs coefficient array { a0, a1, a2, b1, b2, c0, d0 }
+		\param gain output gain of this filter, e.g. a modal amplitude
+		\return true if the filter exists
+		*/
+		bool setCoefficients(uint32_t filter, const double* coeffs, double gain = 1.0)
+		{
+			if (filter >= numFilters)
+				return false;
+
+			// --- d0 + c0*(a0 + a1z^-1 + a2z^-2)/(1 + b1z^-1 + b2z^-2) over the common denominator
+			coeffArray[a0 * stride + filter] = (SampleType)(gain * (coeffs[d0] + coeffs[c0] * coeffs[a0]));
+			coeffArray[a1 * stride + filter] = (SampleType)(gain * (coeffs[d0] * coeffs[b1] + coeffs[c0] * coeffs[a1]));
+			coeffArray[a2 * stride + filter] = (SampleType)(gain * (coeffs[d0] * coeffs[b2] + coeffs[c0] * coeffs[a2]));
+			coeffArray[b1 * stride + filter] = (SampleType)coeffs[b1];
+			coeffArray[b2 * stride + filter] = (SampleType)coeffs[b2];
+			return true;
+		}
+
+		/** design one filter with the AudioFilter algorithms at the bank sample rate; Q <= 0 is designed with
+			Q = 0.707, as AudioFilter::setParameters( ) does; returns false, and leaves the filter unchanged, if the
+			design fails or the filter index is out of range */
+		bool setFilter(uint32_t filter, const AudioFilterParameters& parameters, double gain = 1.0)
+		{
+			// --- don't allow 0 or (-) values for Q
+			AudioFilterParameters designParameters = parameters;
+			if (designParameters.Q <= 0)
+				designParameters.Q = 0.707;
+
+			double coeffs[numCoeffs] = { 0.0 };
+			if (!AudioFilter::calculateFilterCoeffs(designParameters, sampleRate, coeffs))
+				return false;
+			return setCoefficients(filter, coeffs, gain);
+		}
+
+		/** process a block and write the sum of all filter outputs */
+		/**
+		\param in input buffer
+		\param out output buffer (may be the same as in)
+		\param n number of samples
+		*/
+		void processBlockSum(const SampleType* in, SampleType* out, uint32_t n)
+		{
+			SampleType* row = &outputRows[0];
+			for (uint32_t i = 0; i < n; i++)
+			{
+				tick(in[i], row);
+
+				// --- kPadding independent partial sums vectorize without reassociating the adds
+				SampleType partial[kPadding] = {};
+				for (uint32_t filter = 0; filter < stride; filter += kPadding)
+				{
+					for (uint32_t k = 0; k < kPadding; k++)
+						partial[k] += row[filter + k];
+				}
+
+				SampleType sum = 0.0;
+				for (uint32_t k = 0; k < kPadding; k++)
+					sum += partial[k];
+				out[i] = sum;
+			}
+		}
+
+		/** process a block and write every filter to its own output buffer */
+		/**
+		\param in input buffer
+		\param out array of getNumFilters( ) output buffers, none of which may be the input buffer
+		\param n number of samples
+		*/
+		void processBlock(const SampleType* in, SampleType* const* out, uint32_t n)
+		{
+			for (uint32_t offset = 0; offset < n; offset += kOutputChunk)
+			{
+				uint32_t count = n - offset < kOutputChunk ? n - offset : kOutputChunk;
+
+				// --- rows of [sample][filter], then transpose out to the planar buffers
+				for (uint32_t i = 0; i < count; i++)
+					tick(in[offset + i], &outputRows[i * stride]);
+
+				for (uint32_t filter = 0; filter < numFilters; filter++)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						out[filter][offset + i] = outputRows[i * stride + filter];
+				}
+			}
+		}
+
+	protected:
+		enum { numBankCoeffs = b2 + 1 };	///< a0, a1, a2, b1, b2; c0 and d0 are folded in
+		enum { z1, z2, numRegisters };		///< transposed canonical registers
+
+		static constexpr uint32_t kPadding = 16;		///< filter count granularity (one AVX-512 float vector)
+		static constexpr uint32_t kOutputChunk = 16;	///< samples per transpose for per-filter outputs
+
+		std::unique_ptr<SampleType[]> coeffArray = nullptr;	///< [coefficient][filter]
+		std::unique_ptr<SampleType[]> stateArray = nullptr;	///< [register][filter]
+		std::unique_ptr<SampleType[]> outputRows = nullptr;	///< [sample][filter] scratch
+		uint32_t numFilters = 0;	///< number of filters in use
+		uint32_t stride = 0;		///< padded row length
+		double sampleRate = 44100.0;	///< sample rate for setFilter( )
+
+		/** run one input sample through every filter; y receives stride outputs */
+		void tick(SampleType xn, SampleType* y)
+		{
+			const SampleType* A0 = &coeffArray[a0 * stride];
+			const SampleType* A1 = &coeffArray[a1 * stride];
+			const SampleType* A2 = &coeffArray[a2 * stride];
+			const SampleType* B1 = &coeffArray[b1 * stride];
+			const SampleType* B2 = &coeffArray[b2 * stride];
+			SampleType* Z1 = &stateArray[z1 * stride];
+			SampleType* Z2 = &stateArray[z2 * stride];
+
+			for (uint32_t filter = 0; filter < stride; filter++)
+			{
+				// --- y(n) = a0*x(n) + z1, branch-free underflow check
+				SampleType yn = A0[filter] * xn + Z1[filter];
+#ifndef FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE
+				yn = std::fabs(yn) < (SampleType)kSmallestPositiveFloatValue ? (SampleType)0.0 : yn;
+#endif
+				// --- shuffle/update
+				Z1[filter] = A1[filter] * xn - B1[filter] * yn + Z2[filter];
+				Z2[filter] = A2[filter] * xn - B2[filter] * yn;
+				y[filter] = yn;
+			}
+		}
+	};
+} // namespace fxobjects
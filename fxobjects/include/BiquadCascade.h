@@ -0,0 +1,174 @@
+/**
+\class BiquadCascade
+\ingroup FX-Objects
+\brief
+The BiquadCascade object implements a chain of second order sections (transposed canonical form) that
+share one contiguous coefficient array and one contiguous state array. It replaces a chain of
+AudioFilter objects for high order filters: a block is run through every section while it is still
+in cache, with no per-object call overhead between the stages.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setNumSections( ) to allocate the sections (not from the realtime thread)
+- setSectionCoefficients( ) to load a { a0, a1, a2, b1, b2, c0, d0 } array, e.g. AudioFilter::getCoefficients( );
+  the AudioFilter dry/wet mix d0 + c0*H(z) is folded into the section numerator
+- setSection( ) to design a section with any AudioFilter algorithm
+- setFilterDesign( ) to load a whole FilterDesigner design (Butterworth, Chebyshev, Bessel, elliptic of any order)
+*/
+
+#pragma once
+
+#include <memory>
+#include "IAudioSignalProcessor.h"
+#include "EnumsAndStructs.h"
+#include "BiquadKernels.h"
+#include "AudioFilter.h"
+#include "FilterDesigner.h"
+
+namespace fxobjects
+{
+	class BiquadCascade : public IAudioSignalProcessor
+	{
+	public:
+		BiquadCascade() {}		/* C-TOR */
+		~BiquadCascade() {}		/* D-TOR */
+
+		/** reset: flush all section states; the sample rate is stored for setSection( ) */
+		virtual bool reset(double _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			for (uint32_t i = 0; i < numSections * numStates; i++)
+				stateArray[i] = 0.0;
+			return true;
+		}
+
+		/** return false: this object only processes samples */
+		virtual bool canProcessAudioFrame() { return false; }
+
+		/** set the sample rate used by setSection( ); does not redesign existing sections */
+		virtual void setSampleRate(double _sampleRate) { sampleRate = _sampleRate; }
+
+		/** allocate the sections, all initialized as pass-through;
+			do NOT call from realtime audio thread */
+		void setNumSections(uint32_t _numSections)
+		{
+			numSections = _numSections;
+			coeffArray.reset(new double[numSections * numCoeffs]);
+			stateArray.reset(new double[numSections * numStates]);
+
+			for (uint32_t section = 0; section < numSections; section++)
+			{
+				double* coeffs = &coeffArray[section * numCoeffs];
+				for (uint32_t i = 0; i < numCoeffs; i++)
+					coeffs[i] = 0.0;
+				coeffs[a0] = 1.0;
+				coeffs[c0] = 1.0;
+			}
+			for (uint32_t i = 0; i < numSections * numStates; i++)
+				stateArray[i] = 0.0;
+		}
+
+		/** get the number of sections */
+		uint32_t getNumSections() { return numSections; }
+
+		/** load one section from an AudioFilter style coefficient array { a0, a1, a2, b1, b2, c0, d0 } */
+		/**
+		\param section index of the section
+		\param coeffs coefficient array; the output d0*x(n) + c0*y(n) is folded into a0, a1, a2
+		\return true if the section exists
+		*/
+		bool setSectionCoefficients(uint32_t section, const double* coeffs)
+		{
+			if (section >= numSections)
+				return false;
+
+			// --- d0 + c0*(a0 + a1z^-1 + a2z^-2)/(1 + b1z^-1 + b2z^-2) over the common denominator
+			double* sectionCoeffs = &coeffArray[section * numCoeffs];
+			sectionCoeffs[a0] = coeffs[d0] + coeffs[c0] * coeffs[a0];
+			sectionCoeffs[a1] = coeffs[d0] * coeffs[b1] + coeffs[c0] * coeffs[a1];
+			sectionCoeffs[a2] = coeffs[d0] * coeffs[b2] + coeffs[c0] * coeffs[a2];
+			sectionCoeffs[b1] = coeffs[b1];
+			sectionCoeffs[b2] = coeffs[b2];
+			sectionCoeffs[c0] = 1.0;
+			sectionCoeffs[d0] = 0.0;
+			return true;
+		}
+
+		/** design one section with the AudioFilter algorithms at the current sample rate */
+		bool setSection(uint32_t section, const AudioFilterParameters& parameters)
+		{
+			AudioFilter designer;
+			designer.reset(sampleRate);
+			designer.getParametersRef() = parameters;
+			designer.updateParameters();
+			return setSectionCoefficients(section, designer.getCoefficients());
+		}
+
+		/** design a high order filter with FilterDesigner at the current sample rate and load it, allocating
+			FilterDesigner::getNumSections( ) sections and clearing their state;
+			do NOT call from realtime audio thread */
+		/**
+		\param parameters design parameters
+		\return false if FilterDesigner rejects the parameters; the cascade is unchanged
+		*/
+		bool setFilterDesign(const FilterDesignParameters& parameters)
+		{
+			std::unique_ptr<double[]> designedCoeffs(new double[FilterDesigner::getNumSections(parameters) * numCoeffs]);
+			if (!FilterDesigner::designFilter(parameters, sampleRate, designedCoeffs.get()))
+				return false;
+
+			setNumSections(FilterDesigner::getNumSections(parameters));
+			coeffArray = std::move(designedCoeffs);
+			return true;
+		}
+
+		/** get the folded coefficients of one section, or nullptr */
+		const double* getSectionCoefficients(uint32_t section)
+		{
+			if (section >= numSections)
+				return nullptr;
+			return &coeffArray[section * numCoeffs];
+		}
+
+		/** process input x(n) through every section */
+		virtual double processAudioSample(double xn)
+		{
+			for (uint32_t section = 0; section < numSections; section++)
+				xn = BiquadKernel<biquadAlgorithm::kTransposeCanonical>::processSample(&coeffArray[section * numCoeffs], &stateArray[section * numStates], xn);
+			return xn;
+		}
+
+		/** process a block section by section */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+		/** process a block section by section, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
+	protected:
+		std::unique_ptr<double[]> coeffArray = nullptr;	///< numSections x { a0, a1, a2, b1, b2, c0, d0 }
+		std::unique_ptr<double[]> stateArray = nullptr;	///< numSections x { x_z1, x_z2, y_z1, y_z2 }
+		uint32_t numSections = 0;	///< number of sections
+		double sampleRate = 44100.0;	///< sample rate for setSection( )
+
+		/** block worker: each chunk runs through all sections in double precision while it is still in cache */
+		template <typename SampleType>
+		void processBlockT(const SampleType* in, SampleType* out, uint32_t n)
+		{
+			double buffer[BLOCK_SCRATCH_LENGTH];
+			for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+			{
+				uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+				for (uint32_t i = 0; i < count; i++)
+					buffer[i] = in[offset + i];
+
+				for (uint32_t section = 0; section < numSections; section++)
+					processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(&coeffArray[section * numCoeffs], &stateArray[section * numStates], buffer, buffer, count);
+
+				for (uint32_t i = 0; i < count; i++)
+					out[offset + i] = (SampleType)buffer[i];
+			}
+		}
+	};
+} // namespace fxobjects
@@ -0,0 +1,239 @@
+/**
+\struct BiquadKernel
+\ingroup FX-Objects
+\brief
+Compile-time specialized biquad difference equations, one specialization per biquadAlgorithm.
+
+The Biquad object is a thin runtime-selecting facade over these kernels: it decodes the structure
+once per call (or once per block) and hands off to the matching specialization, so the
+inner loop never branches on the structure type.
+
+- processSample( ) runs one sample through the structure using the coefficient and state arrays,
+  in the precision of those arrays (float or double)
+- storageComponent( ) returns the S value used by the Harma loop resolution (phaser)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include "EnumsAndStructs.h"
+#include "helperfunctions.h"
+
+namespace fxobjects {
+
+	template <biquadAlgorithm A>
+	struct BiquadKernel;
+
+	template <>
+	struct BiquadKernel<biquadAlgorithm::kDirect>
+	{
+		template <typename T>
+		static inline T processSample(const T* coeffs, T* state, T xn)
+		{
+			// --- 1)  form output y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
+			T yn = coeffs[a0] * xn +
+				coeffs[a1] * state[x_z1] +
+				coeffs[a2] * state[x_z2] -
+				coeffs[b1] * state[y_z1] -
+				coeffs[b2] * state[y_z2];
+
+			// --- 2) underflow check
+			checkKernelUnderflow(yn);
+
+			// --- 3) update states
+			state[x_z2] = state[x_z1];
+			state[x_z1] = xn;
+
+			state[y_z2] = state[y_z1];
+			state[y_z1] = yn;
+
+			return yn;
+		}
+
+		template <typename T>
+		static inline T storageComponent(const T* coeffs, const T* state)
+		{
+			return coeffs[a1] * state[x_z1] +
+				coeffs[a2] * state[x_z2] -
+				coeffs[b1] * state[y_z1] -
+				coeffs[b2] * state[y_z2];
+		}
+	};
+
+	template <>
+	struct BiquadKernel<biquadAlgorithm::kCanonical>
+	{
+		template <typename T>
+		static inline T processSample(const T* coeffs, T* state, T xn)
+		{
+			// --- w(n) = x(n) - b1*w(n-1) - b2*w(n-2)
+			T wn = xn - coeffs[b1] * state[x_z1] - coeffs[b2] * state[x_z2];
+
+			// --- y(n) = a0*w(n) + a1*w(n-1) + a2*w(n-2)
+			T yn = coeffs[a0] * wn + coeffs[a1] * state[x_z1] + coeffs[a2] * state[x_z2];
+
+			// --- underflow check
+			checkKernelUnderflow(yn);
+
+			// --- update states
+			state[x_z2] = state[x_z1];
+			state[x_z1] = wn;
+
+			return yn;
+		}
+
+		template <typename T>
+		static inline T storageComponent([[maybe_unused]] const T* coeffs, [[maybe_unused]] const T* state) { return (T)0.0; }
+	};
+
+	template <>
+	struct BiquadKernel<biquadAlgorithm::kTransposeDirect>
+	{
+		template <typename T>
+		static inline T processSample(const T* coeffs, T* state, T xn)
+		{
+			// --- w(n) = x(n) + stateArray[y_z1]
+			T wn = xn + state[y_z1];
+
+			// --- y(n) = a0*w(n) + stateArray[x_z1]
+			T yn = coeffs[a0] * wn + state[x_z1];
+
+			// --- underflow check
+			checkKernelUnderflow(yn);
+
+			// --- update states
+			state[y_z1] = state[y_z2] - coeffs[b1] * wn;
+			state[y_z2] = -coeffs[b2] * wn;
+
+			state[x_z1] = state[x_z2] + coeffs[a1] * wn;
+			state[x_z2] = coeffs[a2] * wn;
+
+			return yn;
+		}
+
+		template <typename T>
+		static inline T storageComponent([[maybe_unused]] const T* coeffs, [[maybe_unused]] const T* state) { return (T)0.0; }
+	};
+
+	template <>
+	struct BiquadKernel<biquadAlgorithm::kTransposeCanonical>
+	{
+		template <typename T>
+		static inline T processSample(const T* coeffs, T* state, T xn)
+		{
+			// --- y(n) = a0*x(n) + stateArray[x_z1]
+			T yn = coeffs[a0] * xn + state[x_z1];
+
+			// --- underflow check
+			checkKernelUnderflow(yn);
+
+			// --- shuffle/update
+			state[x_z1] = coeffs[a1] * xn - coeffs[b1] * yn + state[x_z2];
+			state[x_z2] = coeffs[a2] * xn - coeffs[b2] * yn;
+
+			return yn;
+		}
+
+		template <typename T>
+		static inline T storageComponent([[maybe_unused]] const T* coeffs, const T* state) { return state[x_z1]; }
+	};
+
+	/**
+	\struct FirstOrderKernel
+	\ingroup FX-Objects
+	\brief
+	The transposed canonical structure with a2 = b2 = 0: one state, three multiplies. Gives the same output as
+	BiquadKernel<kTransposeCanonical> for first order coefficients; only state[x_z1] is used.
+	*/
+	struct FirstOrderKernel
+	{
+		template <typename T>
+		static inline T processSample(const T* coeffs, T* state, T xn)
+		{
+			// --- y(n) = a0*x(n) + stateArray[x_z1]
+			T yn = coeffs[a0] * xn + state[x_z1];
+
+			// --- underflow check
+			checkKernelUnderflow(yn);
+
+			// --- update
+			state[x_z1] = coeffs[a1] * xn - coeffs[b1] * yn;
+
+			return yn;
+		}
+
+		template <typename T>
+		static inline T storageComponent([[maybe_unused]] const T* coeffs, const T* state) { return state[x_z1]; }
+	};
+
+	/**
+	@processBiquadBlock
+	\ingroup FX-Functions
+
+	@brief runs a block of samples through one biquad structure; coefficients and state are copied
+	into locals for the duration of the block so they can live in registers
+
+	\param coeffs - coefficient array (numCoeffs long); its element type sets the kernel precision
+	\param state - state array (numStates long), updated on return
+	\param in - input buffer
+	\param out - output buffer, may be the same as in
+	\param n - number of samples
+	*/
+	template <biquadAlgorithm A, typename T, typename SampleType>
+	inline void processBiquadBlock(const T* coeffs, T* state, const SampleType* in, SampleType* out, uint32_t n)
+	{
+		T c[numCoeffs];
+		T z[numStates];
+		for (uint32_t i = 0; i < numCoeffs; i++)
+			c[i] = coeffs[i];
+		for (uint32_t i = 0; i < numStates; i++)
+			z[i] = state[i];
+
+		for (uint32_t i = 0; i < n; i++)
+			out[i] = (SampleType)BiquadKernel<A>::processSample(c, z, (T)in[i]);
+
+		for (uint32_t i = 0; i < numStates; i++)
+			state[i] = z[i];
+	}
+
+	/**
+	@processBiquadBlockRamped
+	\ingroup FX-Functions
+
+	@brief as processBiquadBlock, but adds the per-sample increments to the coefficients before each sample;
+	the caller limits n so the ramp does not overshoot its target
+
+	\param coeffs - coefficient array (numCoeffs long), updated on return
+	\param increments - per-sample coefficient increments (numCoeffs long)
+	\param state - state array (numStates long), updated on return
+	\param in - input buffer
+	\param out - output buffer, may be the same as in
+	\param n - number of samples
+	*/
+	template <biquadAlgorithm A, typename T, typename SampleType>
+	inline void processBiquadBlockRamped(T* coeffs, const T* increments, T* state, const SampleType* in, SampleType* out, uint32_t n)
+	{
+		T c[numCoeffs];
+		T dc[numCoeffs];
+		T z[numStates];
+		for (uint32_t i = 0; i < numCoeffs; i++)
+		{
+			c[i] = coeffs[i];
+			dc[i] = increments[i];
+		}
+		for (uint32_t i = 0; i < numStates; i++)
+			z[i] = state[i];
+
+		for (uint32_t i = 0; i < n; i++)
+		{
+			for (uint32_t k = 0; k < numCoeffs; k++)
+				c[k] += dc[k];
+			out[i] = (SampleType)BiquadKernel<A>::processSample(c, z, (T)in[i]);
+		}
+
+		for (uint32_t i = 0; i < numCoeffs; i++)
+			coeffs[i] = c[i];
+		for (uint32_t i = 0; i < numStates; i++)
+			state[i] = z[i];
+	}
+} // namespace fxobjects
@@ -0,0 +1,150 @@
+/**
+\class BiquadN
+\ingroup FX-Objects
+\brief
+The BiquadN object runs up to Lanes independent channels of a transposed canonical biquad side by side.
+Coefficients and z^-1 registers are stored structure-of-arrays ([coefficient][lane], [register][lane])
+so every arithmetic step of the difference equation operates on all lanes at once; with Lanes = 4
+(SSE/NEON float width) or Lanes = 8 (AVX2 float width) the lane loops compile to one vector
+instruction each.
+
+Audio I/O:
+- Processes planar multi-channel blocks: in[channel][sample] -> out[channel][sample], numChannels <= Lanes.
+
+Control I/F:
+- setCoefficients( ) takes the AudioFilter/Biquad coefficient layout { a0, a1, a2, b1, b2, c0, d0 }
+  for all lanes or for one lane, so AudioFilter::getCoefficients( ) can be passed straight in.
+  The output is d0*x(n) + c0*y(n), which reproduces AudioFilter; with the default c0 = 1, d0 = 0
+  it reproduces Biquad (kTransposeCanonical).
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include "EnumsAndStructs.h"
+#include "Constants.h"
+
+namespace fxobjects
+{
+	template <uint32_t Lanes, typename SampleType = float>
+	class BiquadN
+	{
+		static_assert(Lanes > 0, "BiquadN needs at least one lane");
+
+	public:
+		BiquadN() {
+			double passThrough[numCoeffs] = { 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+			setCoefficients(passThrough);
+		}		/* C-TOR */
+		~BiquadN() {}	/* D-TOR */
+
+		/** reset: clear out the state registers of every lane; sample rate is not used */
+		bool reset(double _sampleRate)
+		{
+			for (uint32_t lane = 0; lane < Lanes; lane++)
+			{
+				z1[lane] = 0.0;
+				z2[lane] = 0.0;
+			}
+			return true;
+		}
+
+		/** set the same coefficients on every lane */
+		void setCoefficients(const double* coeffs)
+		{
+			for (uint32_t lane = 0; lane < Lanes; lane++)
+				setCoefficients(lane, coeffs);
+		}
+
+		/** set the coefficients of one lane */
+		void setCoefficients(uint32_t lane, const double* coeffs)
+		{
+			if (lane >= Lanes)
+				return;
+
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				coeffArray[i][lane] = (SampleType)coeffs[i];
+		}
+
+		/** number of channels this object can process at once */
+		static constexpr uint32_t getNumLanes() { return Lanes; }
+
+		/** process a planar block of numChannels (<= Lanes) channels */
+		/**
+		\param in array of numChannels input buffers
+		\param out array of numChannels output buffers (may be the same buffers as in)
+		\param numChannels number of channels
+		\param n number of samples per channel
+		*/
+		void processBlock(const SampleType* const* in, SampleType* const* out, uint32_t numChannels, uint32_t n)
+		{
+			if (numChannels > Lanes)
+				numChannels = Lanes;
+
+			// --- load state into locals for the duration of the block
+			alignas(64) SampleType s1[Lanes];
+			alignas(64) SampleType s2[Lanes];
+			for (uint32_t lane = 0; lane < Lanes; lane++)
+			{
+				s1[lane] = z1[lane];
+				s2[lane] = z2[lane];
+			}
+
+			// --- transpose chunks to [sample][lane] so the lane loops are contiguous
+			alignas(64) SampleType x[BLOCK_SCRATCH_LENGTH][Lanes];
+			alignas(64) SampleType y[BLOCK_SCRATCH_LENGTH][Lanes];
+
+			for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+			{
+				uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					for (uint32_t ch = 0; ch < numChannels; ch++)
+						x[i][ch] = in[ch][offset + i];
+					for (uint32_t lane = numChannels; lane < Lanes; lane++)
+						x[i][lane] = 0.0;
+				}
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					for (uint32_t lane = 0; lane < Lanes; lane++)
+					{
+						// --- y(n) = a0*x(n) + z1, branch-free underflow check
+						SampleType xn = x[i][lane];
+						SampleType yn = coeffArray[a0][lane] * xn + s1[lane];
+#ifndef FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE
+						yn = std::fabs(yn) < (SampleType)kSmallestPositiveFloatValue ? (SampleType)0.0 : yn;
+#endif
+
+						// --- shuffle/update
+						s1[lane] = coeffArray[a1][lane] * xn - coeffArray[b1][lane] * yn + s2[lane];
+						s2[lane] = coeffArray[a2][lane] * xn - coeffArray[b2][lane] * yn;
+
+						// --- (dry) + (processed)
+						y[i][lane] = coeffArray[d0][lane] * xn + coeffArray[c0][lane] * yn;
+					}
+				}
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					for (uint32_t ch = 0; ch < numChannels; ch++)
+						out[ch][offset + i] = y[i][ch];
+				}
+			}
+
+			// --- store state for the next block
+			for (uint32_t lane = 0; lane < Lanes; lane++)
+			{
+				z1[lane] = s1[lane];
+				z2[lane] = s2[lane];
+			}
+		}
+
+	protected:
+		alignas(64) SampleType coeffArray[numCoeffs][Lanes]; ///< coefficients, [coefficient][lane]
+		alignas(64) SampleType z1[Lanes] = {};	///< first z^-1 register of each lane (x_z1 in Biquad)
+		alignas(64) SampleType z2[Lanes] = {};	///< second z^-1 register of each lane (x_z2 in Biquad)
+	};
+} // namespace fxobjects
@@ -0,0 +1,196 @@
+/**
+\class BiquadStateSpace
+\ingroup FX-Objects
+\brief
+The BiquadStateSpace object is a look-ahead (block state-space) form of the transposed canonical biquad
+for a single channel. The recurrence is unrolled BlockSize samples at a time:
+
+	y[0..M-1] = C*s + D*x[0..M-1]
+	s'        = A^M*s + B*x[0..M-1]
+
+where s = { z1, z2 } are the transposed canonical registers, D is the lower triangular matrix of the
+impulse response h[0..M-1], C holds the zero-input response to each register, and A^M, B carry the
+state across the block. Every output of a block is then an independent dot product, so the work
+vectorizes across the M outputs instead of waiting on the serial y(n-1) dependency.
+
+The matrices are rebuilt only when the coefficients change (setCoefficients( )) by running the ordinary
+recurrence over unit states and impulses. Blocks that are not a multiple of BlockSize finish with the
+per-sample recurrence on the same registers, so any block length can be processed.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setCoefficients( ) takes the AudioFilter/Biquad layout { a0, a1, a2, b1, b2, c0, d0 } with the dry/wet
+  mix d0 + c0*H(z) folded into the numerator; AudioFilter::getCoefficients( ) can be passed straight in.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include "IAudioSignalProcessor.h"
+#include "EnumsAndStructs.h"
+#include "helperfunctions.h"
+
+namespace fxobjects
+{
+	template <uint32_t BlockSize = 8>
+	class BiquadStateSpace : public IAudioSignalProcessor
+	{
+		static_assert(BlockSize >= 2 && BlockSize <= 64, "BiquadStateSpace block size must be 2...64");
+
+	public:
+		BiquadStateSpace() {
+			double passThrough[numCoeffs] = { 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+			setCoefficients(passThrough);
+		}		/* C-TOR */
+		~BiquadStateSpace() {}	/* D-TOR */
+
+		/** reset: clear the state registers; sample rate is not used */
+		virtual bool reset(double _sampleRate)
+		{
+			state[0] = 0.0;
+			state[1] = 0.0;
+			return true;
+		}
+
+		/** return false: this object only processes samples */
+		virtual bool canProcessAudioFrame() { return false; }
+
+		/** set the coefficients and rebuild the block matrices */
+		/**
+		\param coeffs coefficient array { a0, a1, a2, b1, b2, c0, d0 }
+		*/
+		void setCoefficients(const double* coeffs)
+		{
+			// --- d0 + c0*(a0 + a1z^-1 + a2z^-2)/(1 + b1z^-1 + b2z^-2) over the common denominator
+			coeffArray[a0] = coeffs[d0] + coeffs[c0] * coeffs[a0];
+			coeffArray[a1] = coeffs[d0] * coeffs[b1] + coeffs[c0] * coeffs[a1];
+			coeffArray[a2] = coeffs[d0] * coeffs[b2] + coeffs[c0] * coeffs[a2];
+			coeffArray[b1] = coeffs[b1];
+			coeffArray[b2] = coeffs[b2];
+			coeffArray[c0] = 1.0;
+			coeffArray[d0] = 0.0;
+
+			calculateBlockMatrices();
+		}
+
+		/** number of samples computed per block step */
+		static constexpr uint32_t getBlockSize() { return BlockSize; }
+
+		/** process input x(n) with the per-sample recurrence */
+		virtual double processAudioSample(double xn)
+		{
+			return tick(xn);
+		}
+
+		/** process a block; whole BlockSize steps use the state-space form */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+		/** process a block, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
+	protected:
+		double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };	///< folded biquad coefficients
+		double state[2] = { 0.0, 0.0 };	///< transposed canonical registers { z1, z2 }
+
+		enum { kDim = BlockSize + 2 };	///< block inputs/outputs plus the two registers
+
+		/** block transition matrix, stored by input column: transition[j][k] is the weight of input j on output k,
+			with inputs { x[0..M-1], z1, z2 } and outputs { y[0..M-1], z1', z2' }, i.e. [ D C ; B A^M ] */
+		double transition[kDim][kDim] = {};
+
+		/** transposed canonical recurrence on the shared registers */
+		inline double tick(double xn)
+		{
+			double yn = coeffArray[a0] * xn + state[0];
+			checkKernelUnderflow(yn);
+			state[0] = coeffArray[a1] * xn - coeffArray[b1] * yn + state[1];
+			state[1] = coeffArray[a2] * xn - coeffArray[b2] * yn;
+			return yn;
+		}
+
+		/** rebuild the transition matrix by running the recurrence over unit impulses and unit states */
+		void calculateBlockMatrices()
+		{
+			double saved[2] = { state[0], state[1] };
+
+			// --- D and B: zero state, unit impulse at input sample j
+			for (uint32_t j = 0; j < BlockSize; j++)
+			{
+				state[0] = 0.0;
+				state[1] = 0.0;
+				for (uint32_t k = 0; k < BlockSize; k++)
+					transition[j][k] = simulate(k == j ? 1.0 : 0.0);
+				transition[j][BlockSize] = state[0];
+				transition[j][BlockSize + 1] = state[1];
+			}
+
+			// --- C and A^M: zero input, unit register
+			for (uint32_t reg = 0; reg < 2; reg++)
+			{
+				state[0] = reg == 0 ? 1.0 : 0.0;
+				state[1] = reg == 1 ? 1.0 : 0.0;
+				for (uint32_t k = 0; k < BlockSize; k++)
+					transition[BlockSize + reg][k] = simulate(0.0);
+				transition[BlockSize + reg][BlockSize] = state[0];
+				transition[BlockSize + reg][BlockSize + 1] = state[1];
+			}
+
+			state[0] = saved[0];
+			state[1] = saved[1];
+		}
+
+		/** recurrence without the underflow check, for the matrix build */
+		inline double simulate(double xn)
+		{
+			double yn = coeffArray[a0] * xn + state[0];
+			state[0] = coeffArray[a1] * xn - coeffArray[b1] * yn + state[1];
+			state[1] = coeffArray[a2] * xn - coeffArray[b2] * yn;
+			return yn;
+		}
+
+		/** block worker */
+		template <typename SampleType>
+		void processBlockT(const SampleType* in, SampleType* out, uint32_t n)
+		{
+			// --- u = { x[0..M-1], z1, z2 }, v = { y[0..M-1], z1', z2' }; v = T*u, one input column at a time
+			double u[kDim];
+			u[BlockSize] = state[0];
+			u[BlockSize + 1] = state[1];
+
+			uint32_t i = 0;
+			for (; i + BlockSize <= n; i += BlockSize)
+			{
+				for (uint32_t k = 0; k < BlockSize; k++)
+					u[k] = in[i + k];
+
+				double v[kDim] = {};
+				for (uint32_t j = 0; j < kDim; j++)
+				{
+					for (uint32_t k = 0; k < kDim; k++)
+						v[k] += transition[j][k] * u[j];
+				}
+
+				for (uint32_t k = 0; k < BlockSize; k++)
+					out[i + k] = (SampleType)v[k];
+
+				u[BlockSize] = v[BlockSize];
+				u[BlockSize + 1] = v[BlockSize + 1];
+#ifndef FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE
+				// --- the block form skips the per-sample check, so flush the registers once per step
+				u[BlockSize] = fabs(u[BlockSize]) < kSmallestPositiveFloatValue ? 0.0 : u[BlockSize];
+				u[BlockSize + 1] = fabs(u[BlockSize + 1]) < kSmallestPositiveFloatValue ? 0.0 : u[BlockSize + 1];
+#endif
+			}
+
+			state[0] = u[BlockSize];
+			state[1] = u[BlockSize + 1];
+
+			// --- remainder with the per-sample recurrence
+			for (; i < n; i++)
+				out[i] = (SampleType)tick(in[i]);
+		}
+	};
+} // namespace fxobjects
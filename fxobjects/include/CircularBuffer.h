@@ -18,6 +18,7 @@ The CircularBuffer object implements a simple circular buffer. It uses a wrap ma
 #include <cstring>
 #include <memory>
 #include <cmath>
+#include "helperfunctions.h"
 
 namespace fxobjects
 {
@@ -4,9 +4,9 @@
 namespace fxobjects {
     
     // Math constants
-    const double kPi = 3.14159265358979323846264338327950288419716939937510582097494459230781640628620899;
-    const double kTwoPi = 2.0 * kPi;
-    const double kSqrtTwo = 1.41421356237309504880168872420969807856967187537694807317667973799;  // √2
+    constexpr double kPi = 3.14159265358979323846264338327950288419716939937510582097494459230781640628620899;
+    constexpr double kTwoPi = 2.0 * kPi;
+    constexpr double kSqrtTwo = 1.41421356237309504880168872420969807856967187537694807317667973799;  // √2
     
     const double kSmallestPositiveFloatValue = 1.175494351e-38;         /* min positive value */
     const double kSmallestNegativeFloatValue = -1.175494351e-38;         /* min negative value */
@@ -36,6 +36,9 @@ namespace fxobjects {
 	const float ENVELOPE_DIGITAL_TC = -4.6051701859880913680359829093687;///< ln(1%)
 	const float ENVELOPE_ANALOG_TC = -1.0023934309275667804345424248947; ///< ln(36.7%)
 
+	// --- length of the stack scratch buffers used by the block processing overrides
+	const uint32_t BLOCK_SCRATCH_LENGTH = 64;
+
 	// --- constants for Phaser
 	const unsigned int PHASER_STAGES = 6;
 
@@ -0,0 +1,277 @@
+/**
+\class CrossoverN
+\ingroup FX-Objects
+\brief
+The CrossoverN object splits a signal into Bands phase coherent Linkwitz-Riley bands in one pass: the bands sum
+to an allpass of the input (flat magnitude), so they can be processed separately and added back together.
+
+The bands are split in a balanced tree: the root splits the band range in the middle, each half is split again,
+and so on, so every sample goes through about log2(Bands) low or high pass stages instead of one per band. A band
+also needs the phase shift of every crossover that is not on its path through the tree; since the allpasses
+commute, the compensation for a whole subtree is applied once, on the branch before it is split further.
+
+- kLR2: second order LWR low/high pass (AudioFilter kLWRLPF2/kLWRHPF2); the high branch is inverted at each
+  split so the bands sum to an allpass, and the compensation is the first order allpass LP - HP
+- kLR4: two Butterworth sections (kButterLPF2/kButterHPF2) per branch; the compensation is the second order
+  allpass LP + HP with the Butterworth poles
+
+Each crossover's low pass, high pass and allpass coefficients are shared by every stage that uses them. The
+sections run in double precision.
+
+Audio I/O:
+- Processes mono input to Bands planar band outputs.
+
+Control I/F:
+- setCrossoverFrequency( ) / setCrossoverFrequencies( ) for the Bands - 1 crossover frequencies, in ascending order
+- setCrossoverType( ) for LR2 or LR4
+- the coefficients are recalculated at the start of the next block; updateCoefficients( ) does it now
+*/
+
+#pragma once
+
+#include <cstdint>
+#include "EnumsAndStructs.h"
+#include "BiquadKernels.h"
+#include "AudioFilter.h"
+
+namespace fxobjects
+{
+	template <uint32_t Bands>
+	class CrossoverN
+	{
+		static_assert(Bands >= 2, "CrossoverN needs at least two bands");
+
+	public:
+		CrossoverN()
+		{
+			// --- default crossovers an octave apart from 100 Hz
+			double fc = 100.0;
+			for (uint32_t i = 0; i < kNumCrossovers; i++)
+			{
+				frequencies[i] = fc;
+				fc *= 2.0;
+			}
+
+			uint32_t numSplits = 0;
+			buildTree(0, Bands, numSplits);
+		}		/* C-TOR */
+		~CrossoverN() {}	/* D-TOR */
+
+		/** reset: flush all section states and redesign at the new sample rate */
+		bool reset(double _sampleRate)
+		{
+			if (sampleRate != _sampleRate)
+				coeffsDirty = true;
+			sampleRate = _sampleRate;
+
+			for (Split& split : splits)
+			{
+				clearStates(split.lowPassStates, 2);
+				clearStates(split.highPassStates, 2);
+				clearStates(split.lowAllpassStates, kMaxAllpasses);
+				clearStates(split.highAllpassStates, kMaxAllpasses);
+			}
+			return true;
+		}
+
+		/** number of bands */
+		static constexpr uint32_t getNumBands() { return Bands; }
+
+		/** set one crossover frequency */
+		/**
+		\param crossover index, 0 to Bands - 2; crossover i is between band i and band i + 1
+		\param fc frequency in Hz
+		*/
+		void setCrossoverFrequency(uint32_t crossover, double fc)
+		{
+			if (crossover >= kNumCrossovers || frequencies[crossover] == fc)
+				return;
+
+			frequencies[crossover] = fc;
+			coeffsDirty = true;
+		}
+
+		/** set all Bands - 1 crossover frequencies, in ascending order */
+		void setCrossoverFrequencies(const double* fc)
+		{
+			for (uint32_t i = 0; i < kNumCrossovers; i++)
+				setCrossoverFrequency(i, fc[i]);
+		}
+
+		/** get one crossover frequency */
+		double getCrossoverFrequency(uint32_t crossover) { return crossover < kNumCrossovers ? frequencies[crossover] : 0.0; }
+
+		/** set LR2 or LR4 slopes */
+		void setCrossoverType(crossoverType _type)
+		{
+			if (type == _type)
+				return;
+
+			type = _type;
+			coeffsDirty = true;
+		}
+
+		/** get the crossover type */
+		crossoverType getCrossoverType() { return type; }
+
+		/** recalculate the coefficients if a setting changed since the last block;
+			processBlock( ) calls this first */
+		bool updateCoefficients()
+		{
+			if (!coeffsDirty)
+				return false;
+			coeffsDirty = false;
+
+			AudioFilterParameters parameters;
+			for (uint32_t i = 0; i < kNumCrossovers; i++)
+			{
+				Crossover& crossover = crossovers[i];
+				parameters.fc = frequencies[i];
+				if (type == crossoverType::kLR2)
+				{
+					parameters.algorithm = filterAlgorithm::kLWRLPF2;
+					AudioFilter::calculateFilterCoeffs(parameters, sampleRate, crossover.lowPass);
+					parameters.algorithm = filterAlgorithm::kLWRHPF2;
+					AudioFilter::calculateFilterCoeffs(parameters, sampleRate, crossover.highPass);
+
+					// --- inverted high branch
+					crossover.highPass[a0] = -crossover.highPass[a0];
+					crossover.highPass[a1] = -crossover.highPass[a1];
+					crossover.highPass[a2] = -crossover.highPass[a2];
+
+					// --- the denominator is (1 + p*z^-1)^2; LP - HP = (p + z^-1)/(1 + p*z^-1)
+					double p = 0.5 * crossover.lowPass[b1];
+					double allpass[numCoeffs] = { p, 1.0, 0.0, p, 0.0, 1.0, 0.0 };
+					copyCoeffs(allpass, crossover.allpass);
+				}
+				else
+				{
+					parameters.algorithm = filterAlgorithm::kButterLPF2;
+					AudioFilter::calculateFilterCoeffs(parameters, sampleRate, crossover.lowPass);
+					parameters.algorithm = filterAlgorithm::kButterHPF2;
+					AudioFilter::calculateFilterCoeffs(parameters, sampleRate, crossover.highPass);
+
+					// --- LP^2 + HP^2 = (b2 + b1*z^-1 + z^-2)/(1 + b1*z^-1 + b2*z^-2)
+					double allpass[numCoeffs] = { crossover.lowPass[b2], crossover.lowPass[b1], 1.0, crossover.lowPass[b1], crossover.lowPass[b2], 1.0, 0.0 };
+					copyCoeffs(allpass, crossover.allpass);
+				}
+			}
+			return true;
+		}
+
+		/** split a block into the bands */
+		/**
+		\param in input buffer; may be bands[0]
+		\param bands array of Bands output buffers
+		\param n number of samples
+		*/
+		void processBlock(const float* in, float* const* bands, uint32_t n) { processBlockT(in, bands, n); }
+
+		/** split a block into the bands, double precision version */
+		void processBlock(const double* in, double* const* bands, uint32_t n) { processBlockT(in, bands, n); }
+
+	protected:
+		static constexpr uint32_t kNumCrossovers = Bands - 1;
+		static constexpr uint32_t kMaxAllpasses = Bands > 2 ? Bands - 2 : 1;	///< compensation stages per branch
+
+		/** shared coefficients of one crossover frequency */
+		struct Crossover
+		{
+			double lowPass[numCoeffs] = { 0.0 };
+			double highPass[numCoeffs] = { 0.0 };
+			double allpass[numCoeffs] = { 0.0 };
+		};
+
+		/** one node of the tree: splits bands [lowBand, endBand) at crossover highBand - 1 */
+		struct Split
+		{
+			uint32_t lowBand = 0;
+			uint32_t highBand = 0;
+			uint32_t endBand = 0;
+
+			// --- crossovers of the other branch, applied as allpasses
+			uint32_t lowAllpasses[kMaxAllpasses] = { 0 };
+			uint32_t numLowAllpasses = 0;
+			uint32_t highAllpasses[kMaxAllpasses] = { 0 };
+			uint32_t numHighAllpasses = 0;
+
+			double lowPassStates[2][numStates] = { { 0.0 } };
+			double highPassStates[2][numStates] = { { 0.0 } };
+			double lowAllpassStates[kMaxAllpasses][numStates] = { { 0.0 } };
+			double highAllpassStates[kMaxAllpasses][numStates] = { { 0.0 } };
+		};
+
+		Crossover crossovers[kNumCrossovers];	///< coefficients per crossover frequency
+		Split splits[kNumCrossovers];			///< the tree in preorder, so a branch is split after its parent
+		double frequencies[kNumCrossovers] = { 0.0 };	///< crossover frequencies
+		crossoverType type = crossoverType::kLR4;	///< LR2 or LR4
+		double sampleRate = 44100.0;			///< current sample rate
+		bool coeffsDirty = true;				///< a setting changed; recalculate before the next block
+
+		/** add the split of bands [lowBand, endBand) and its subtrees, in preorder */
+		void buildTree(uint32_t lowBand, uint32_t endBand, uint32_t& numSplits)
+		{
+			if (endBand - lowBand < 2)
+				return;
+
+			Split& split = splits[numSplits++];
+			split.lowBand = lowBand;
+			split.highBand = (lowBand + endBand) / 2;
+			split.endBand = endBand;
+
+			// --- the low branch needs the crossovers inside the high branch, and vice versa
+			for (uint32_t crossover = split.highBand; crossover + 1 < endBand; crossover++)
+				split.lowAllpasses[split.numLowAllpasses++] = crossover;
+			for (uint32_t crossover = lowBand; crossover + 1 < split.highBand; crossover++)
+				split.highAllpasses[split.numHighAllpasses++] = crossover;
+
+			buildTree(lowBand, split.highBand, numSplits);
+			buildTree(split.highBand, endBand, numSplits);
+		}
+
+		static void copyCoeffs(const double* source, double* destination)
+		{
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				destination[i] = source[i];
+		}
+
+		static void clearStates(double (*states)[numStates], uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				for (uint32_t j = 0; j < numStates; j++)
+					states[i][j] = 0.0;
+			}
+		}
+
+		/** block worker: each split reads its branch from the first band buffer of its range and writes the two
+			branches in place into the first band buffers of the halves, so no band is copied */
+		template <typename SampleType>
+		void processBlockT(const SampleType* in, SampleType* const* bands, uint32_t n)
+		{
+			updateCoefficients();
+
+			const uint32_t numStages = type == crossoverType::kLR2 ? 1 : 2;
+			for (Split& split : splits)
+			{
+				const SampleType* source = split.lowBand == 0 && split.endBand == Bands ? in : bands[split.lowBand];
+				SampleType* low = bands[split.lowBand];
+				SampleType* high = bands[split.highBand];
+				const Crossover& crossover = crossovers[split.highBand - 1];
+
+				// --- high branch first, so the low branch can overwrite the source
+				processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(crossover.highPass, split.highPassStates[0], source, high, n);
+				for (uint32_t stage = 1; stage < numStages; stage++)
+					processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(crossover.highPass, split.highPassStates[stage], high, high, n);
+				for (uint32_t i = 0; i < split.numHighAllpasses; i++)
+					processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(crossovers[split.highAllpasses[i]].allpass, split.highAllpassStates[i], high, high, n);
+
+				processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(crossover.lowPass, split.lowPassStates[0], source, low, n);
+				for (uint32_t stage = 1; stage < numStages; stage++)
+					processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(crossover.lowPass, split.lowPassStates[stage], low, low, n);
+				for (uint32_t i = 0; i < split.numLowAllpasses; i++)
+					processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(crossovers[split.lowAllpasses[i]].allpass, split.lowAllpassStates[i], low, low, n);
+			}
+		}
+	};
+} // namespace fxobjects
@@ -0,0 +1,101 @@
+/**
+\class ScopedDenormalGuard
+\ingroup FX-Objects
+\brief
+RAII guard that switches the FPU of the calling thread to flush denormal results (and operands) to zero
+for its lifetime, then restores the previous mode:
+- x86/x64: MXCSR FTZ (bit 15) and DAZ (bit 6)
+- AArch64: FPCR FZ (bit 24)
+- anything else: no-op
+
+Construct one at the top of the audio callback (or around any processBlock( ) call) and recursive tails
+decay to zero in hardware instead of stalling on denormal arithmetic. Builds that always process under
+a guard can define FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE to compile the per-sample checkKernelUnderflow( )
+branches out of the biquad and detector kernels.
+
+Note that the hardware flush happens at the type's own denormal threshold (about 1e-308 for double),
+not at the float threshold used by checkFloatUnderflow( ).
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FXOBJECTS_DENORMAL_GUARD_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#define FXOBJECTS_DENORMAL_GUARD_ARM64 1
+#endif
+
+namespace fxobjects
+{
+	class ScopedDenormalGuard
+	{
+	public:
+		ScopedDenormalGuard()		/* C-TOR */
+		{
+#if defined(FXOBJECTS_DENORMAL_GUARD_X86)
+			previousMode = _mm_getcsr();
+			_mm_setcsr((uint32_t)previousMode | kX86FlushToZero | kX86DenormalsAreZero);
+#elif defined(FXOBJECTS_DENORMAL_GUARD_ARM64)
+			previousMode = getFPCR();
+			setFPCR(previousMode | kArmFlushToZero);
+#endif
+		}
+
+		~ScopedDenormalGuard()		/* D-TOR */
+		{
+#if defined(FXOBJECTS_DENORMAL_GUARD_X86)
+			_mm_setcsr((uint32_t)previousMode);
+#elif defined(FXOBJECTS_DENORMAL_GUARD_ARM64)
+			setFPCR(previousMode);
+#endif
+		}
+
+		ScopedDenormalGuard(const ScopedDenormalGuard&) = delete;
+		ScopedDenormalGuard& operator=(const ScopedDenormalGuard&) = delete;
+
+		/** true if this platform has a hardware flush mode the guard can set */
+		static constexpr bool isSupported()
+		{
+#if defined(FXOBJECTS_DENORMAL_GUARD_X86) || defined(FXOBJECTS_DENORMAL_GUARD_ARM64)
+			return true;
+#else
+			return false;
+#endif
+		}
+
+	private:
+		uint64_t previousMode = 0;	///< control register contents to restore
+
+		static constexpr uint64_t kX86FlushToZero = 0x8000;		///< MXCSR FTZ
+		static constexpr uint64_t kX86DenormalsAreZero = 0x0040;	///< MXCSR DAZ
+		static constexpr uint64_t kArmFlushToZero = (uint64_t)1 << 24;	///< FPCR FZ
+
+#if defined(FXOBJECTS_DENORMAL_GUARD_ARM64)
+		static uint64_t getFPCR()
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			return (uint64_t)_ReadStatusReg(ARM64_FPCR);
+#else
+			uint64_t fpcr = 0;
+			__asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+			return fpcr;
+#endif
+		}
+
+		static void setFPCR(uint64_t fpcr)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			_WriteStatusReg(ARM64_FPCR, (__int64)fpcr);
+#else
+			__asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+#endif
+		}
+#endif
+	};
+} // namespace fxobjects
@@ -47,7 +47,7 @@ namespace fxobjects {
 	// Audio Filter Parameters
 	struct AudioFilterParameters
 	{
-		AudioFilterParameters() {}
+		constexpr AudioFilterParameters() {}
 		/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 		AudioFilterParameters& operator=(const AudioFilterParameters& params)	// need this override for collections to work
 		{
@@ -72,6 +72,78 @@ namespace fxobjects {
 		double k = 0.0;
 	};
 
+	/**
+	\enum filterPrototype
+	\ingroup Constants-Enums
+	\brief
+	Use this strongly typed enum to set the analog prototype of a FilterDesigner design
+
+	- enum class filterPrototype { kButterworth, kChebyshevI, kChebyshevII, kBessel, kElliptic };
+	*/
+	enum class filterPrototype { kButterworth, kChebyshevI, kChebyshevII, kBessel, kElliptic };
+
+	/**
+	\enum filterBandType
+	\ingroup Constants-Enums
+	\brief
+	Use this strongly typed enum to set the band type of a FilterDesigner design
+
+	- enum class filterBandType { kLowpass, kHighpass, kBandpass, kBandstop };
+	*/
+	enum class filterBandType { kLowpass, kHighpass, kBandpass, kBandstop };
+
+	/**
+	\struct FilterDesignParameters
+	\ingroup FX-Objects
+	\brief
+	Custom parameter structure for the FilterDesigner: an arbitrary order prototype, transformed to a band type
+	and discretized with the (prewarped) bilinear transform. The meaning of fc depends on the prototype:
+
+	- kButterworth, kBessel: the -3 dB frequency
+	- kChebyshevI, kElliptic: the passband edge, where the response leaves the passbandRipple_dB band
+	- kChebyshevII: the stopband edge, where the response reaches -stopbandAttenuation_dB
+
+	For kBandpass and kBandstop, fc is the (geometric) center frequency and the edges are fc/Q apart.
+	*/
+	struct FilterDesignParameters
+	{
+		FilterDesignParameters() {}
+		/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+		FilterDesignParameters& operator=(const FilterDesignParameters& params)	// need this override for collections to work
+		{
+			if (this == &params)
+				return *this;
+			prototype = params.prototype;
+			bandType = params.bandType;
+			order = params.order;
+			fc = params.fc;
+			Q = params.Q;
+			passbandRipple_dB = params.passbandRipple_dB;
+			stopbandAttenuation_dB = params.stopbandAttenuation_dB;
+
+			return *this;
+		}
+
+		// --- individual parameters
+		filterPrototype prototype = filterPrototype::kButterworth;	///< analog prototype
+		filterBandType bandType = filterBandType::kLowpass;	///< low/high/band pass or band stop
+		uint32_t order = 4;				///< prototype order; band pass and band stop designs have twice as many poles
+		double fc = 1000.0;				///< cutoff or center frequency (Hz), see above
+		double Q = 0.707;				///< kBandpass, kBandstop: fc/bandwidth
+		double passbandRipple_dB = 1.0;	///< kChebyshevI, kElliptic: peak to peak passband ripple
+		double stopbandAttenuation_dB = 60.0;	///< kChebyshevII, kElliptic: minimum stopband attenuation
+	};
+
+	/**
+	\enum crossoverType
+	\ingroup Constants-Enums
+	\brief
+	Use this strongly typed enum to set the Linkwitz-Riley order of a CrossoverN
+
+	- enum class crossoverType { kLR2, kLR4 };
+	*/
+	enum class crossoverType { kLR2, kLR4 };
+
 	/**
 	\struct AudioDetectorParameters
 	\ingroup FX-Objects
@@ -118,6 +190,24 @@ namespace fxobjects {
 		double quadPhaseOutput_neg = 0.0;	///< -90 degrees out
 	};
 
+	/**
+	\enum lfoOutput
+	\ingroup Constants-Enums
+	\brief
+	Use this strongly typed enum to select one of the SignalGenData outputs, e.g. the LFO phase of a channel
+
+	- enum class lfoOutput { kNormal, kInverted, kQuadPhasePos, kQuadPhaseNeg };
+
+	lfoOutputBit( ) gives the bit of an output in an LFO output mask (e.g. for LFO::renderBlock( )); kAllLFOOutputs
+	selects all four.
+	*/
+	enum class lfoOutput { kNormal, kInverted, kQuadPhasePos, kQuadPhaseNeg };
+
+	/** bit of an lfoOutput in an LFO output mask */
+	constexpr uint32_t lfoOutputBit(lfoOutput output) { return 1u << (uint32_t)output; }
+
+	constexpr uint32_t kAllLFOOutputs = 0x0F;	///< mask with all four lfoOutput bits
+
 	/**
 	\enum generatorWaveform
 	\ingroup Constants-Enums
@@ -213,6 +303,7 @@ namespace fxobjects {
 				: lfoAmplitude_fac; // keep current value if out of range
 			intensity_Pct = params.intensity_Pct;
 			quadPhaseLFO = params.quadPhaseLFO;
+			modulationInterval = params.modulationInterval > 0 ? params.modulationInterval : 1;
 			return *this;
 		}
 
@@ -222,6 +313,7 @@ namespace fxobjects {
 		double lfoAmplitude_fac = 1.0; // amplitude factor [0, +1], 0 is no amplitude
 		double intensity_Pct = 0.0;	///< phaser feedback in %
 		bool quadPhaseLFO = false;	///< quad phase LFO flag
+		uint32_t modulationInterval = 1;	///< samples per LFO/APF update, interpolated in between; 1 = every sample
 	};
 
 	// homework chapter 13-2
@@ -55,8 +55,8 @@ namespace fxobjects
 		/** reset members to initialized state */
 		virtual bool reset(double _sampleRate)
 		{
+			// --- both recalculate for the new sample rate before the first sample
 			filter.reset(_sampleRate);
-			filter.calculateFilterCoeffs();
 			detector.reset(_sampleRate);
 			return true;
 		}
@@ -135,7 +135,59 @@ namespace fxobjects
 			return filter.processAudioSample(xn);
 		}
 
+		/** process a block through the envelope follower; the detector runs on whole chunks and the
+			filter runs on the stretches of samples that share the same modulated fc */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+		/** process a block through the envelope follower, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
 	protected:
+		/** block worker, shared by the float and double overrides */
+		template <typename SampleType>
+		void processBlockT(const SampleType* in, SampleType* out, uint32_t n)
+		{
+			// --- calc threshold once per block
+			const double threshValue = pow(10.0, parameters.threshold_dB / 20.0);
+			double xBuffer[BLOCK_SCRATCH_LENGTH];
+			double fcBuffer[BLOCK_SCRATCH_LENGTH];
+
+			ZVAFilterParameters filterParams = filter.getParameters();
+
+			for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+			{
+				uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+				for (uint32_t i = 0; i < count; i++)
+					xBuffer[i] = in[offset + i];
+
+				// --- detect the chunk, then compute the modulated fc for each sample
+				detector.processBlock(xBuffer, fcBuffer, count);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					double deltaValue = pow(10.0, fcBuffer[i] / 20.0) - threshValue;
+					fcBuffer[i] = deltaValue > 0.0 ? doUnipolarModulationFromMin(deltaValue * parameters.sensitivity, parameters.fc, kMaxFilterFrequency)
+												   : parameters.fc;
+				}
+
+				// --- filter each run of samples that share the same fc
+				uint32_t runStart = 0;
+				while (runStart < count)
+				{
+					uint32_t runEnd = runStart + 1;
+					while (runEnd < count && fcBuffer[runEnd] == fcBuffer[runStart])
+						runEnd++;
+
+					filterParams.fc = fcBuffer[runStart];
+					filter.setParameters(filterParams);
+					filter.processBlock(xBuffer + runStart, xBuffer + runStart, runEnd - runStart);
+					runStart = runEnd;
+				}
+
+				for (uint32_t i = 0; i < count; i++)
+					out[offset + i] = (SampleType)xBuffer[i];
+			}
+		}
+
 		EnvelopeFollowerParameters parameters; ///< object parameters
 
 		// --- 1 filter and 1 detector
@@ -0,0 +1,334 @@
+/**
+\file FastMath.h
+\ingroup FX-Functions
+\brief
+Accuracy tiers for the transcendental functions in the coefficient design equations (AudioFilter, ZVAFilter,
+the WDF filter examples). Every function comes in three tiers, selected per object with a mathAccuracy value:
+
+- kExact: the C library (std::tan, std::exp, pow(10, x), ...); results match the original design code
+- kHigh: range reduction plus polynomial/rational approximation, about 1e-7 relative error or better
+- kLow: the same reductions with shorter approximations, about 1e-4 relative error or better
+
+Measured worst case relative error against libm (benchmarks/FastMathAccuracy prints the full report):
+
+	function	kHigh		kLow
+	tan			6e-11		2.1e-6
+	sin/cos		1.6e-10		5e-6
+	exp/pow10	7e-9		5.6e-5
+	log10		2e-9		3.6e-6
+
+In the AudioFilter designs this is below 1e-6 dB (kHigh) and 0.06 dB (kLow) of magnitude response for every
+algorithm except the matched (kMatch*) designs at low Q, whose numerators come from differences of nearly
+equal terms and magnify any coefficient error: up to 0.002 dB (kHigh) and several dB (kLow) near Nyquist.
+Use kExact or kHigh for those.
+
+Speed: a design waits on each function result, so the kernels are written for a short dependency chain (FPU
+rounding, paired series terms, a select instead of a quadrant branch). Per AudioFilter coefficient update kHigh
+is then never slower than kExact: about even for the designs that only need one sin/cos pair (kLPF2, kHPF2,
+kMatchLP2B), where the C library is already quick, and up to 35 % faster for the ones with pow(10, x) (shelves,
+para EQs); kLow typically takes another 10 - 20 % off (see benchmarks/FastMathAccuracy).
+
+Arguments outside the reduction range (|x| >= 1e6 for the trig functions, exp overflow/underflow, non-finite
+or non-positive log arguments) fall back to the C library in every tier, so the tiers only differ in rounding
+and never in special cases. sqrt( ) is one instruction on every target this library supports and is used
+as-is in all tiers; fastSqrt( ) exists so design code can replace pow(x, 0.5) without a libm pow( ) call.
+
+The function templates take the tier as a template argument and compile to straight-line code; the overloads
+with a runtime mathAccuracy argument are for the objects that only compute a handful of values per update.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "Constants.h"
+
+namespace fxobjects
+{
+	/**
+	\enum mathAccuracy
+	\ingroup Constants-Enums
+	\brief
+	Accuracy tier for coefficient design math; see FastMath.h.
+
+	- enum class mathAccuracy { kExact, kHigh, kLow };
+	*/
+	enum class mathAccuracy { kExact, kHigh, kLow };
+
+	namespace fastmath
+	{
+		constexpr double kLog2e = 1.44269504088896340735992468100189214;	///< 1/ln(2)
+		constexpr double kLn2 = 0.693147180559945309417232121458176568;		///< ln(2)
+		constexpr double kLn10 = 2.30258509299404568401799145468436421;		///< ln(10)
+		constexpr double kLog10_2 = 0.301029995663981195213738894724493027;	///< log10(2)
+		constexpr double kTwoOverPi = 0.636619772367581343075535053490057448;	///< 2/pi
+		constexpr double kMaxTrigArgument = 1.0e6;		///< beyond this the reduction loses accuracy; use libm
+		constexpr double kMinExpArgument = -708.0;		///< 2^n scaling stays normal above this
+		constexpr double kMaxExpArgument = 709.0;		///< and below this
+
+		constexpr double kRoundMagic = 6755399441055744.0;	///< 1.5 * 2^52: x + kRoundMagic rounds x to an integer
+
+		/** round to nearest for |x| < 2^51: adding and subtracting 1.5 * 2^52 stays in the FPU, where a round
+			trip through int64_t would put two conversions on the dependency chain of every reduction */
+		inline double roundSmall(double x)
+		{
+			return (x + kRoundMagic) - kRoundMagic;
+		}
+
+		/** 2^n for an integer valued n in [-1022, 1023] */
+		inline double exp2Int(double n)
+		{
+			uint64_t bits = (uint64_t)((int64_t)n + 1023) << 52;
+			double value = 0.0;
+			memcpy(&value, &bits, sizeof(double));
+			return value;
+		}
+
+		/** reduce x to r in [-pi/4, pi/4] with x = r + quadrant*pi/2; returns the quadrant mod 4 */
+		inline uint32_t reduceQuarterPi(double x, double& r)
+		{
+			double k = roundSmall(x * kTwoOverPi);
+
+			// --- pi/2 in two parts so that k*pi/2 is exact enough for |k| up to kMaxTrigArgument
+			r = (x - k * 1.5707963267341256141662597656250) - k * 6.07710050650619224932e-11;
+			return (uint32_t)((int64_t)k & 3);
+		}
+
+		// --- the kernels evaluate their series in pairs of terms (Estrin's scheme) rather than one term at a
+		//     time: the design equations wait on each result, so the length of the dependency chain, not the
+		//     number of operations, is what they pay for
+
+		/** sin(r) for |r| <= pi/4 */
+		template <mathAccuracy accuracy>
+		inline double sinKernel(double r)
+		{
+			double r2 = r * r;
+			double r4 = r2 * r2;
+			if (accuracy == mathAccuracy::kLow)
+				return r + r * r2 * ((-1.0 / 6.0 + r2 * (1.0 / 120.0)) - r4 * (1.0 / 5040.0));
+			return r + r * r2 * ((-1.0 / 6.0 + r2 * (1.0 / 120.0)) + r4 * ((-1.0 / 5040.0 + r2 * (1.0 / 362880.0)) - r4 * (1.0 / 39916800.0)));
+		}
+
+		/** cos(r) for |r| <= pi/4 */
+		template <mathAccuracy accuracy>
+		inline double cosKernel(double r)
+		{
+			double r2 = r * r;
+			double r4 = r2 * r2;
+			if (accuracy == mathAccuracy::kLow)
+				return 1.0 + r2 * ((-0.5 + r2 * (1.0 / 24.0)) - r4 * (1.0 / 720.0));
+			return 1.0 + r2 * ((-0.5 + r2 * (1.0 / 24.0)) + r4 * ((-1.0 / 720.0 + r2 * (1.0 / 40320.0)) - r4 * (1.0 / 3628800.0)));
+		}
+
+		/** tan(r) for |r| <= pi/4 as numerator / denominator: Lambert continued fraction truncated to a [3/4] (kLow)
+			or [5/6] (kHigh) rational */
+		template <mathAccuracy accuracy>
+		inline void tanKernelParts(double r, double& numerator, double& denominator)
+		{
+			double r2 = r * r;
+			if (accuracy == mathAccuracy::kLow)
+			{
+				numerator = r * (105.0 - 10.0 * r2);
+				denominator = 105.0 + r2 * (-45.0 + r2);
+				return;
+			}
+			double r4 = r2 * r2;
+			numerator = r * ((10395.0 - 1260.0 * r2) + 21.0 * r4);
+			denominator = (10395.0 - 4725.0 * r2) + r4 * (210.0 - r2);
+		}
+
+		/** tan(r) for |r| <= pi/4 */
+		template <mathAccuracy accuracy>
+		inline double tanKernel(double r)
+		{
+			double numerator = 0.0;
+			double denominator = 0.0;
+			tanKernelParts<accuracy>(r, numerator, denominator);
+			return numerator / denominator;
+		}
+
+		/** e^r for |r| <= ln(2)/2: Taylor series to r^4 (kLow) or r^7 (kHigh) */
+		template <mathAccuracy accuracy>
+		inline double expKernel(double r)
+		{
+			double r2 = r * r;
+			if (accuracy == mathAccuracy::kLow)
+				return (1.0 + r) + r2 * ((0.5 + r * (1.0 / 6.0)) + r2 * (1.0 / 24.0));
+			double r4 = r2 * r2;
+			return ((1.0 + r) + r2 * (0.5 + r * (1.0 / 6.0))) +
+				r4 * ((1.0 / 24.0 + r * (1.0 / 120.0)) + r2 * (1.0 / 720.0 + r * (1.0 / 5040.0)));
+		}
+	}
+
+	/** tan(x) */
+	template <mathAccuracy accuracy>
+	inline double fastTan(double x)
+	{
+		if (accuracy == mathAccuracy::kExact || !(fabs(x) < fastmath::kMaxTrigArgument))
+			return std::tan(x);
+
+		double r = 0.0;
+		uint32_t quadrant = fastmath::reduceQuarterPi(x, r);
+
+		// --- odd quadrants: tan(r + pi/2) = -1/tan(r), i.e. the same rational upside down; one division either way
+		double numerator = 0.0;
+		double denominator = 0.0;
+		fastmath::tanKernelParts<accuracy>(r, numerator, denominator);
+		bool odd = (quadrant & 1) != 0;
+		return (odd ? -denominator : numerator) / (odd ? numerator : denominator);
+	}
+
+	/** sin(x) */
+	template <mathAccuracy accuracy>
+	inline double fastSin(double x)
+	{
+		if (accuracy == mathAccuracy::kExact || !(fabs(x) < fastmath::kMaxTrigArgument))
+			return std::sin(x);
+
+		// --- both kernels and a select instead of a switch on the quadrant: no branch to mispredict as fc sweeps
+		//     across quadrants; odd quadrants swap sin/cos, sin is negated in quadrants 2 and 3
+		double r = 0.0;
+		uint32_t quadrant = fastmath::reduceQuarterPi(x, r);
+		double sinR = fastmath::sinKernel<accuracy>(r);
+		double cosR = fastmath::cosKernel<accuracy>(r);
+		double value = (quadrant & 1) ? cosR : sinR;
+		return (quadrant & 2) ? -value : value;
+	}
+
+	/** cos(x) */
+	template <mathAccuracy accuracy>
+	inline double fastCos(double x)
+	{
+		if (accuracy == mathAccuracy::kExact || !(fabs(x) < fastmath::kMaxTrigArgument))
+			return std::cos(x);
+
+		// --- as fastSin( ); cos is negated in quadrants 1 and 2
+		double r = 0.0;
+		uint32_t quadrant = fastmath::reduceQuarterPi(x, r);
+		double sinR = fastmath::sinKernel<accuracy>(r);
+		double cosR = fastmath::cosKernel<accuracy>(r);
+		double value = (quadrant & 1) ? sinR : cosR;
+		return ((quadrant + 1) & 2) ? -value : value;
+	}
+
+	/** e^x: x = (n + f)*ln(2) with |f| <= 1/2, e^x = 2^n * e^(f*ln(2)), Taylor series for the second factor */
+	template <mathAccuracy accuracy>
+	inline double fastExp(double x)
+	{
+		if (accuracy == mathAccuracy::kExact || !(x > fastmath::kMinExpArgument && x < fastmath::kMaxExpArgument))
+			return std::exp(x);
+
+		double t = x * fastmath::kLog2e;
+		double n = fastmath::roundSmall(t);
+		double r = (t - n) * fastmath::kLn2;
+		return fastmath::expKernel<accuracy>(r) * fastmath::exp2Int(n);
+	}
+
+	/** 10^x, i.e. pow(10.0, x) */
+	template <mathAccuracy accuracy>
+	inline double fastPow10(double x)
+	{
+		if (accuracy == mathAccuracy::kExact)
+			return pow(10.0, x);
+		return fastExp<accuracy>(x * fastmath::kLn10);
+	}
+
+	/** cosh(x) */
+	template <mathAccuracy accuracy>
+	inline double fastCosh(double x)
+	{
+		if (accuracy == mathAccuracy::kExact)
+			return std::cosh(x);
+		double e = fastExp<accuracy>(fabs(x));
+		return 0.5 * (e + 1.0 / e);
+	}
+
+	/** log10(x): x = m*2^e with m in [sqrt(2)/2, sqrt(2)), ln(m) = 2*atanh((m - 1)/(m + 1)) as an odd series */
+	template <mathAccuracy accuracy>
+	inline double fastLog10(double x)
+	{
+		// --- zero, negative, subnormal, inf and NaN go to libm
+		if (accuracy == mathAccuracy::kExact || !(x >= 2.2250738585072014e-308 && x <= 1.7976931348623157e308))
+			return std::log10(x);
+
+		uint64_t bits = 0;
+		memcpy(&bits, &x, sizeof(double));
+		double exponent = (double)((int64_t)((bits >> 52) & 0x7ff) - 1023);
+		bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+		double m = 0.0;
+		memcpy(&m, &bits, sizeof(double));
+		if (m > kSqrtTwo)
+		{
+			m *= 0.5;
+			exponent += 1.0;
+		}
+
+		double s = (m - 1.0) / (m + 1.0);
+		double s2 = s * s;
+		double lnM = 0.0;
+		if (accuracy == mathAccuracy::kLow)
+			lnM = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0)));
+		else
+			lnM = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 + s2 * (1.0 / 7.0 + s2 * (1.0 / 9.0)))));
+
+		return exponent * fastmath::kLog10_2 + lnM * (fastmath::kLog10_2 * fastmath::kLog2e);
+	}
+
+	/** sqrt(x), i.e. pow(x, 0.5) */
+	template <mathAccuracy accuracy>
+	inline double fastSqrt(double x)
+	{
+		return std::sqrt(x);
+	}
+
+	// --- runtime tier selection
+	/** tan(x) at a runtime selected accuracy */
+	inline double fastTan(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastTan<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastTan<mathAccuracy::kLow>(x) : fastTan<mathAccuracy::kExact>(x);
+	}
+
+	/** sin(x) at a runtime selected accuracy */
+	inline double fastSin(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastSin<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastSin<mathAccuracy::kLow>(x) : fastSin<mathAccuracy::kExact>(x);
+	}
+
+	/** cos(x) at a runtime selected accuracy */
+	inline double fastCos(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastCos<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastCos<mathAccuracy::kLow>(x) : fastCos<mathAccuracy::kExact>(x);
+	}
+
+	/** e^x at a runtime selected accuracy */
+	inline double fastExp(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastExp<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastExp<mathAccuracy::kLow>(x) : fastExp<mathAccuracy::kExact>(x);
+	}
+
+	/** 10^x at a runtime selected accuracy */
+	inline double fastPow10(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastPow10<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastPow10<mathAccuracy::kLow>(x) : fastPow10<mathAccuracy::kExact>(x);
+	}
+
+	/** log10(x) at a runtime selected accuracy */
+	inline double fastLog10(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastLog10<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastLog10<mathAccuracy::kLow>(x) : fastLog10<mathAccuracy::kExact>(x);
+	}
+
+	/** sqrt(x) at a runtime selected accuracy (the same in every tier) */
+	inline double fastSqrt(double x, mathAccuracy accuracy)
+	{
+		return accuracy == mathAccuracy::kHigh ? fastSqrt<mathAccuracy::kHigh>(x) :
+			accuracy == mathAccuracy::kLow ? fastSqrt<mathAccuracy::kLow>(x) : fastSqrt<mathAccuracy::kExact>(x);
+	}
+} // namespace fxobjects
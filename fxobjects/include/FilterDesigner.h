@@ -0,0 +1,59 @@
+/**
+\class FilterDesigner
+\ingroup FX-Objects
+\brief
+The FilterDesigner computes Butterworth, Chebyshev I/II, Bessel and elliptic low pass, high pass, band pass and
+band stop filters of arbitrary order as a chain of second order sections in the AudioFilter coefficient layout
+{ a0, a1, a2, b1, b2, c0, d0 } (with c0 = 1, d0 = 0), ready for BiquadCascade::setSectionCoefficients( ), or
+use BiquadCascade::setFilterDesign( ) to do both in one call.
+
+The design runs in the usual steps: analog prototype poles and zeros for a 1 rad/sec edge (the Bessel poles
+are the roots of the reverse Bessel polynomial, found with Aberth iteration on the polynomial's three term
+recurrence evaluated in double-double precision, accurate to about 1e-16 at every order up to kMaxOrder; the
+elliptic poles and zeros use the Landen transformation for the Jacobi elliptic functions), frequency
+transformation to the prewarped band edges, then the bilinear transform. The sections are formed for numerical
+robustness:
+
+- the pole pair closest to the unit circle is paired with the zeros nearest to it, then the next, and so on,
+  so each section's zeros partly cancel its own resonance
+- the sections are ordered from the lowest to the highest Q, so the sharpest resonance is last and the
+  early sections cannot overload the later ones
+- each section has the same gain at the passband reference frequency (DC, Nyquist or the band center)
+  rather than one overall gain factor in the first section
+
+A first order (odd) remainder is stored as a biquad with a2 = b2 = 0.
+
+Designing allocates and is not realtime safe.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include "EnumsAndStructs.h"
+
+namespace fxobjects
+{
+	class FilterDesigner
+	{
+	public:
+		static constexpr uint32_t kMaxOrder = 32;	///< highest prototype order
+
+		/** number of second order sections the design will have */
+		/**
+		\param parameters design parameters
+		\return (order + 1)/2 for low and high pass, order for band pass and band stop
+		*/
+		static uint32_t getNumSections(const FilterDesignParameters& parameters);
+
+		/** design the filter */
+		/**
+		\param parameters design parameters
+		\param sampleRate sample rate
+		\param coeffArrays receives getNumSections( ) { a0, a1, a2, b1, b2, c0, d0 } arrays back to back, in
+		processing order
+		\return false if the parameters are out of range (order 0 or above kMaxOrder, band edges not inside
+		(0, Nyquist), ripple or attenuation not positive, ripple not below the attenuation); coeffArrays is untouched
+		*/
+		static bool designFilter(const FilterDesignParameters& parameters, double sampleRate, double* coeffArrays);
+	};
+} // namespace fxobjects
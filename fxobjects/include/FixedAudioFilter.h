@@ -0,0 +1,187 @@
+/**
+\class FixedAudioFilter
+\ingroup FX-Objects
+\brief
+An AudioFilter that never moves: algorithm, fc, Q, boost/cut and sample rate are compile-time constants, e.g.
+DC blockers, fixed crossovers or the loop filter of a BBD delay. The coefficients are computed by the compiler
+(bakeAudioFilterCoeffs( ), AudioFilterDesign.h), so nothing is designed at construction or reset( ), and the
+block kernel runs on constants the compiler folds into the loop; a design with d0 = 0, c0 = 1 drops the
+dry/wet mix entirely.
+
+Design is a struct of static constexpr members:
+
+	struct DCBlocker
+	{
+		static constexpr filterAlgorithm algorithm = filterAlgorithm::kHPF1;
+		static constexpr double fc = 5.0;
+		static constexpr double Q = 0.707;
+		static constexpr double boostCut_dB = 0.0;
+		static constexpr double sampleRate = 48000.0;
+	};
+
+	FixedAudioFilter<DCBlocker> dcBlocker;
+
+reset( ) at any other sample rate designs once with the exact (kExact) equations and runs the same transposed
+canonical kernel on the stored coefficients.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include "IAudioSignalProcessor.h"
+#include "EnumsAndStructs.h"
+#include "BiquadKernels.h"
+#include "AudioFilterDesign.h"
+#include "FrequencyResponse.h"
+
+namespace fxobjects
+{
+	/** --- a designed coefficient array converted to the kernel precision, at compile time */
+	template <typename SampleType>
+	constexpr std::array<SampleType, numCoeffs> toKernelCoeffs(const std::array<double, numCoeffs>& coeffs)
+	{
+		std::array<SampleType, numCoeffs> kernel = {};
+		for (uint32_t i = 0; i < numCoeffs; i++)
+			kernel[i] = (SampleType)coeffs[i];
+		return kernel;
+	}
+
+	template <typename Design, typename SampleType = double>
+	class FixedAudioFilter : public IAudioSignalProcessor
+	{
+		static_assert(Design::sampleRate > 0.0, "FixedAudioFilter: Design::sampleRate must be positive");
+		static_assert(Design::fc > 0.0 && Design::fc < Design::sampleRate / 2.0, "FixedAudioFilter: Design::fc must be in (0, Nyquist)");
+		static_assert(Design::Q > 0.0, "FixedAudioFilter: Design::Q must be positive");
+
+	public:
+		FixedAudioFilter() {}		/* C-TOR */
+		~FixedAudioFilter() {}		/* D-TOR */
+
+		/** the { a0, a1, a2, b1, b2, c0, d0 } array for Design, computed at compile time */
+		static constexpr std::array<double, numCoeffs> bakedCoeffs = bakeAudioFilterCoeffs<Design::algorithm>(Design::fc,
+			Design::Q, Design::sampleRate, Design::boostCut_dB);
+
+		// --- IAudioSignalProcessor
+		/** flush the state; only a sample rate other than Design::sampleRate runs the design equations */
+		virtual bool reset(double _sampleRate)
+		{
+			memset(&stateArray[0], 0, sizeof(SampleType) * numStates);
+
+			sampleRate = _sampleRate;
+			useBakedCoeffs = _sampleRate == Design::sampleRate;
+			if (useBakedCoeffs)
+			{
+				for (uint32_t i = 0; i < numCoeffs; i++)
+					coeffArray[i] = bakedCoeffs[i];
+			}
+			else
+			{
+				AudioFilterParameters parameters;
+				parameters.algorithm = Design::algorithm;
+				parameters.fc = Design::fc;
+				parameters.Q = Design::Q;
+				parameters.boostCut_dB = Design::boostCut_dB;
+				designAudioFilter<Design::algorithm, FastDesignMath<mathAccuracy::kExact>>(parameters, _sampleRate, coeffArray);
+			}
+
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				kernelCoeffs[i] = (SampleType)coeffArray[i];
+
+			return true;
+		}
+
+		/** return false: this object only processes samples */
+		virtual bool canProcessAudioFrame() { return false; }
+
+		/** process input x(n) through the filter to produce return value y(n) */
+		virtual double processAudioSample(double xn)
+		{
+			if (useBakedCoeffs)
+				return processSampleT(bakedKernelCoeffs.data(), xn);
+			return processSampleT(kernelCoeffs, xn);
+		}
+
+		/** process a block through the filter */
+		virtual void processBlock(const float* in, float* out, uint32_t n)
+		{
+			if (useBakedCoeffs)
+				processBlockT(bakedKernelCoeffs.data(), in, out, n);
+			else
+				processBlockT(kernelCoeffs, in, out, n);
+		}
+
+		/** process a block through the filter, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n)
+		{
+			if (useBakedCoeffs)
+				processBlockT(bakedKernelCoeffs.data(), in, out, n);
+			else
+				processBlockT(kernelCoeffs, in, out, n);
+		}
+
+		/** --- get the current coefficient array { a0, a1, a2, b1, b2, c0, d0 } */
+		const double* getCoefficients() { return &coeffArray[0]; }
+
+		/** --- magnitude and phase of the current design, evaluated from coeffArray rather than measured; see
+			FrequencyResponse.h */
+		/**
+		\param frequencies count frequencies in Hz
+		\param count number of frequencies
+		\param magnitude_dB receives count magnitudes in dB
+		\param phase receives count phases in radians; may be nullptr
+		*/
+		void getFrequencyResponse(const double* frequencies, uint32_t count, double* magnitude_dB, double* phase = nullptr)
+		{
+			getBiquadFrequencyResponse(coeffArray, sampleRate, frequencies, count, magnitude_dB, phase);
+		}
+
+		/** --- true if the filter is running on the compile-time coefficients */
+		bool usingBakedCoeffs() { return useBakedCoeffs; }
+
+	protected:
+		/** --- bakedCoeffs in the kernel precision */
+		static constexpr std::array<SampleType, numCoeffs> bakedKernelCoeffs = toKernelCoeffs<SampleType>(bakedCoeffs);
+
+		double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };		///< current design
+		SampleType kernelCoeffs[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };	///< current design in the kernel precision
+		SampleType stateArray[numStates] = { 0.0, 0.0, 0.0, 0.0 };					///< transposed canonical state
+		double sampleRate = Design::sampleRate;	///< current sample rate
+		bool useBakedCoeffs = false;	///< reset( ) at Design::sampleRate
+
+		/** --- (dry) + (processed) = x(n)*d0 + y(n)*c0 */
+		inline double processSampleT(const SampleType* coeffs, double xn)
+		{
+			SampleType yn = BiquadKernel<biquadAlgorithm::kTransposeCanonical>::processSample(coeffs, stateArray, (SampleType)xn);
+			return coeffs[d0] * xn + coeffs[c0] * yn;
+		}
+
+		/** --- block worker; with the baked coefficients the mix test and the coefficients are constants */
+		template <typename BufferType>
+		inline void processBlockT(const SampleType* coeffs, const BufferType* in, BufferType* out, uint32_t n)
+		{
+			if (coeffs[d0] == 0.0 && coeffs[c0] == 1.0)
+			{
+				processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(coeffs, stateArray, in, out, n);
+				return;
+			}
+
+			SampleType c[numCoeffs];
+			SampleType z[numStates];
+			for (uint32_t i = 0; i < numCoeffs; i++)
+				c[i] = coeffs[i];
+			for (uint32_t i = 0; i < numStates; i++)
+				z[i] = stateArray[i];
+
+			for (uint32_t i = 0; i < n; i++)
+			{
+				SampleType xn = (SampleType)in[i];
+				SampleType yn = BiquadKernel<biquadAlgorithm::kTransposeCanonical>::processSample(c, z, xn);
+				out[i] = (BufferType)(c[d0] * xn + c[c0] * yn);
+			}
+
+			for (uint32_t i = 0; i < numStates; i++)
+				stateArray[i] = z[i];
+		}
+	};
+} // namespace fxobjects
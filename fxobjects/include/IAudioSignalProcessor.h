@@ -20,6 +20,22 @@ namespace fxobjects {
 		/** process one sample in and out */
 		virtual double processAudioSample(double xn) = 0;
 
+		/** process a block of n samples; in and out may point to the same buffer
+			--- default falls back to processAudioSample( ) per sample; derived objects
+				override this to hoist parameter decoding out of the loop */
+		virtual void processBlock(const float* in, float* out, uint32_t n)
+		{
+			for (uint32_t i = 0; i < n; i++)
+				out[i] = (float)processAudioSample(in[i]);
+		}
+
+		/** process a block of n samples, double precision version; see above */
+		virtual void processBlock(const double* in, double* out, uint32_t n)
+		{
+			for (uint32_t i = 0; i < n; i++)
+				out[i] = processAudioSample(in[i]);
+		}
+
 		/**	added for filter object switching in WDFIdealRLC Example,
 			using a pointer to base class IAudioSignalProcessor */
 		virtual void setParameters(const WDFParameters& _wdfParameters) {}
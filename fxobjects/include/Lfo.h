@@ -7,6 +7,7 @@ audio frequencies except for the sinusoidal output which, though an approximatio
 
 Audio I/O:
 - Output only object: low frequency generator.
+- renderAudioOutput( ) renders all four outputs of one sample; renderBlock( ) renders blocks of selected outputs.
 
 Control I/F:
 - Use OscillatorParameters structure to get/set object params.
@@ -29,11 +30,14 @@ Control I/F:
 namespace fxobjects
 {
     
-    class LFO : public IAudioSignalGenerator
+    /** LFO with a SampleType (float or double) timebase; the SignalGenData outputs stay double.
+        LFO is BasicLFO<double>. */
+    template <typename SampleType = double>
+    class BasicLFO : public IAudioSignalGenerator
     {
     public:
-        LFO() {	srand((uint32_t)time(NULL)); }	/* C-TOR */
-        virtual ~LFO() {}				/* D-TOR */
+        BasicLFO() {	srand((uint32_t)time(NULL)); }	/* C-TOR */
+        virtual ~BasicLFO() {}				/* D-TOR */
     
         /** reset members to initialized state */
         virtual bool reset(double _sampleRate)
@@ -70,96 +74,59 @@ namespace fxobjects
         /** render a new audio output structure */
         virtual const SignalGenData renderAudioOutput()
         {
-            // --- always first!
-            checkAndWrapModulo(modCounter, phaseInc);
-
-            // --- QP output always follows location of current modulo; first set equal
-            modCounterQP = modCounter;
-
-            // --- then, advance modulo by quadPhaseInc = 0.25 = 90 degrees, AND wrap if needed
-            advanceAndCheckWrapModulo(modCounterQP, 0.25);
-
             SignalGenData output;
-            generatorWaveform waveform = lfoParameters.waveform;
-
-            // --- calculate the oscillator value
-            if (waveform == generatorWaveform::kSin)
-            {
-                // --- calculate normal angle
-                double angle = modCounter*2.0*kPi - kPi;
-
-                // --- norm output with parabolicSine approximation
-                output.normalOutput = parabolicSine(-angle);
-
-                // --- calculate QP angle
-                angle = modCounterQP*2.0*kPi - kPi;
-
-                // --- calc QP output
-                output.quadPhaseOutput_pos = parabolicSine(-angle);
-            }
-            else if (waveform == generatorWaveform::kTriangle)
-            {
-                // triv saw
-                output.normalOutput = unipolarToBipolar(modCounter);
-
-                // bipolar triagle
-                output.normalOutput = 2.0*fabs(output.normalOutput) - 1.0;
-
-                // -- quad phase
-                output.quadPhaseOutput_pos = unipolarToBipolar(modCounterQP);
-
-                // bipolar triagle
-                output.quadPhaseOutput_pos = 2.0*fabs(output.quadPhaseOutput_pos) - 1.0;
-            }
-            else if (waveform == generatorWaveform::kSaw)
-            {
-                output.normalOutput = unipolarToBipolar(modCounter);
-                output.quadPhaseOutput_pos = unipolarToBipolar(modCounterQP);
-            }
-
-            // --- invert two main outputs to make the opposite versions
-            output.quadPhaseOutput_neg = -output.quadPhaseOutput_pos;
-            output.invertedOutput = -output.normalOutput;
-
-            // --- setup for next sample period
-            advanceModulo(modCounter, phaseInc);
-
-            // homework chapter 13 - 1
-            // all outputs scaled by lfoParameters.amplitude_fac to set lfo amplitude [0.0, +1.0]
-            // convert first, scale after or output values will be wrong
-            // scaling using lambda function
-            auto scaleOutputs = [&]() {
-                output.normalOutput *= lfoParameters.amplitude_fac;
-                output.invertedOutput *= lfoParameters.amplitude_fac;
-                output.quadPhaseOutput_pos *= lfoParameters.amplitude_fac;
-                output.quadPhaseOutput_neg *= lfoParameters.amplitude_fac;
-            };
-
-            if (polarity == Polarity::kUnipolar)
-            {
-                output.normalOutput = bipolarToUnipolar(output.normalOutput);
-                output.invertedOutput = bipolarToUnipolar(output.invertedOutput);
-                output.quadPhaseOutput_pos = bipolarToUnipolar(output.quadPhaseOutput_pos);
-                output.quadPhaseOutput_neg = bipolarToUnipolar(output.quadPhaseOutput_neg);
-
-                scaleOutputs();
+            renderBlock(1, kAllLFOOutputs, &output.normalOutput, &output.invertedOutput,
+                        &output.quadPhaseOutput_pos, &output.quadPhaseOutput_neg);
+            return output;
+        }
 
-                return output;
-            }
-            else
+        /** render a block of LFO output into one array per output, writing only the outputs in outputsMask;
+            the waveform and polarity are resolved once per block, and the quad phase timebase only runs when a
+            quad phase output is requested. renderAudioOutput( ) is the one sample, all outputs case. */
+        /**
+        \param n number of samples
+        \param outputsMask lfoOutputBit( ) of each output to render, OR'd together
+        \param normal receives n normal outputs; needed for kNormal only
+        \param inverted receives n inverted outputs; needed for kInverted only
+        \param quadPhasePos receives n +90 degree outputs; needed for kQuadPhasePos only
+        \param quadPhaseNeg receives n -90 degree outputs; needed for kQuadPhaseNeg only
+        */
+        void renderBlock(uint32_t n, uint32_t outputsMask, double* normal, double* inverted = nullptr,
+                         double* quadPhasePos = nullptr, double* quadPhaseNeg = nullptr)
+        {
+            switch (lfoParameters.waveform)
             {
-                scaleOutputs();
-
-                return output;
-
+            case generatorWaveform::kSin:
+                renderBlockPolarity<generatorWaveform::kSin>(n, outputsMask, normal, inverted, quadPhasePos, quadPhaseNeg);
+                break;
+            case generatorWaveform::kTriangle:
+                renderBlockPolarity<generatorWaveform::kTriangle>(n, outputsMask, normal, inverted, quadPhasePos, quadPhaseNeg);
+                break;
+            case generatorWaveform::kSaw:
+                renderBlockPolarity<generatorWaveform::kSaw>(n, outputsMask, normal, inverted, quadPhasePos, quadPhaseNeg);
+                break;
             }
         }
-        
+
         void setPolarity(Polarity _polarity)
         {
             polarity = _polarity;
         }
-        
+
+        /** advance the timebase by a number of samples without rendering them, e.g. for a modulator that
+            only renders once per control interval */
+        /**
+        \param samples number of samples to skip
+        */
+        void skipSamples(uint32_t samples)
+        {
+            modCounter += phaseInc*(SampleType)samples;
+
+            // --- wrap into [0.0, +1.0); the next render wraps the upper edge as usual
+            if (modCounter >= 1.0 || modCounter < 0.0)
+                modCounter -= floor(modCounter);
+        }
+
     protected:
         // --- parameters
         OscillatorParameters lfoParameters; ///< object parameters
@@ -168,16 +135,16 @@ namespace fxobjects
         double sampleRate = 0.0;			///< sample rate
     
         // --- timebase variables
-        double modCounter = 0.0;			///< modulo counter [0.0, +1.0]
-        double phaseInc = 0.0;				///< phase inc = fo/fs
-        double modCounterQP = 0.25;			///<Quad Phase modulo counter [0.0, +1.0]
+        SampleType modCounter = 0.0;			///< modulo counter [0.0, +1.0]
+        SampleType phaseInc = 0.0;				///< phase inc = fo/fs
+        SampleType modCounterQP = 0.25;			///<Quad Phase modulo counter [0.0, +1.0]
 
         // homework chapter 13-2
         Polarity polarity = Polarity::kUnipolar; // hard coded unipolar
 
     
         /** check the modulo counter and wrap if needed */
-        inline bool checkAndWrapModulo(double& moduloCounter, double phaseInc)
+        inline bool checkAndWrapModulo(SampleType& moduloCounter, SampleType phaseInc)
         {
             // --- for positive frequencies
             if (phaseInc > 0 && moduloCounter >= 1.0)
@@ -197,7 +164,7 @@ namespace fxobjects
         }
     
         /** advanvce the modulo counter, then check the modulo counter and wrap if needed */
-        inline bool advanceAndCheckWrapModulo(double& moduloCounter, double phaseInc)
+        inline bool advanceAndCheckWrapModulo(SampleType& moduloCounter, SampleType phaseInc)
         {
             // --- advance counter
             moduloCounter += phaseInc;
@@ -220,7 +187,91 @@ namespace fxobjects
         }
     
         /** advanvce the modulo counter */
-        inline void advanceModulo(double& moduloCounter, double phaseInc) { moduloCounter += phaseInc; }
+        inline void advanceModulo(SampleType& moduloCounter, SampleType phaseInc) { moduloCounter += phaseInc; }
+
+        /** bipolar value of a waveform at a modulo counter position */
+        template <generatorWaveform Waveform>
+        inline double waveformValue(SampleType moduloCounter)
+        {
+            if constexpr (Waveform == generatorWaveform::kSin)
+            {
+                // --- calculate angle, output with parabolicSine approximation
+                double angle = moduloCounter*2.0*kPi - kPi;
+                return parabolicSine(-angle);
+            }
+            else if constexpr (Waveform == generatorWaveform::kTriangle)
+            {
+                // --- triv saw to bipolar triangle
+                return 2.0*fabs(unipolarToBipolar(moduloCounter)) - 1.0;
+            }
+            else
+                return unipolarToBipolar(moduloCounter);
+        }
+
+        /** polarity conversion and amplitude of one output value */
+        template <bool Unipolar>
+        inline double scaleOutput(double value, double amplitude)
+        {
+            // homework chapter 13 - 1
+            // all outputs scaled by lfoParameters.amplitude_fac to set lfo amplitude [0.0, +1.0]
+            // convert first, scale after or output values will be wrong
+            if constexpr (Unipolar)
+                value = bipolarToUnipolar(value);
+            return value*amplitude;
+        }
+
+        /** renderBlock( ) worker, polarity dispatch */
+        template <generatorWaveform Waveform>
+        void renderBlockPolarity(uint32_t n, uint32_t outputsMask, double* normal, double* inverted, double* quadPhasePos, double* quadPhaseNeg)
+        {
+            if (polarity == Polarity::kUnipolar)
+                renderBlockT<Waveform, true>(n, outputsMask, normal, inverted, quadPhasePos, quadPhaseNeg);
+            else
+                renderBlockT<Waveform, false>(n, outputsMask, normal, inverted, quadPhasePos, quadPhaseNeg);
+        }
+
+        /** renderBlock( ) worker for one waveform and polarity */
+        template <generatorWaveform Waveform, bool Unipolar>
+        void renderBlockT(uint32_t n, uint32_t outputsMask, double* normal, double* inverted, double* quadPhasePos, double* quadPhaseNeg)
+        {
+            const bool renderNormal = (outputsMask & lfoOutputBit(lfoOutput::kNormal)) != 0;
+            const bool renderInverted = (outputsMask & lfoOutputBit(lfoOutput::kInverted)) != 0;
+            const bool renderQuadPhasePos = (outputsMask & lfoOutputBit(lfoOutput::kQuadPhasePos)) != 0;
+            const bool renderQuadPhaseNeg = (outputsMask & lfoOutputBit(lfoOutput::kQuadPhaseNeg)) != 0;
+            const bool renderQuadPhase = renderQuadPhasePos || renderQuadPhaseNeg;
+            const double amplitude = lfoParameters.amplitude_fac;
+
+            for (uint32_t s = 0; s < n; s++)
+            {
+                // --- always first!
+                checkAndWrapModulo(modCounter, phaseInc);
+
+                if (renderNormal || renderInverted)
+                {
+                    double value = waveformValue<Waveform>(modCounter);
+                    if (renderNormal)
+                        normal[s] = scaleOutput<Unipolar>(value, amplitude);
+                    if (renderInverted)
+                        inverted[s] = scaleOutput<Unipolar>(-value, amplitude);
+                }
+
+                if (renderQuadPhase)
+                {
+                    // --- QP output always follows location of current modulo, advanced by 0.25 = 90 degrees
+                    modCounterQP = modCounter;
+                    advanceAndCheckWrapModulo(modCounterQP, 0.25);
+
+                    double value = waveformValue<Waveform>(modCounterQP);
+                    if (renderQuadPhasePos)
+                        quadPhasePos[s] = scaleOutput<Unipolar>(value, amplitude);
+                    if (renderQuadPhaseNeg)
+                        quadPhaseNeg[s] = scaleOutput<Unipolar>(-value, amplitude);
+                }
+
+                // --- setup for next sample period
+                advanceModulo(modCounter, phaseInc);
+            }
+        }
     
         const double B = 4.0 / kPi;
         const double C = -4.0 / (kPi* kPi);
@@ -233,5 +284,7 @@ namespace fxobjects
             return y;
         }
     };
+
+    using LFO = BasicLFO<double>;
 } // namespace fxobjects
 
@@ -12,6 +12,9 @@ The LinearBuffer object implements a linear buffer of type T. It allows easy wra
 
 #pragma once
 
+#include <cstring>
+#include <memory>
+
 namespace fxobjects
 {
     template <typename T>
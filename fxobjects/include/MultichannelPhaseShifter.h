@@ -0,0 +1,394 @@
+/**
+\class MultichannelPhaseShifter
+\ingroup FX-Objects
+\brief
+The MultichannelPhaseShifter object implements the six-stage PhaseShifter for up to Channels channels with one
+LFO and one set of APF designs. Each channel takes its modulation from one of the four LFO outputs (normal,
+inverted, +90 and -90 degrees), so the channels can be spread in quarter cycle steps, e.g. normal on the left and
+kQuadPhasePos on the right for the usual stereo phaser. The APF coefficients are designed once per LFO output
+in use, not once per channel: a stereo pair on one output costs one design per update, a quadrature pair two.
+
+The APF cascade and the delay-free loop resolution (the G products and the S feedback sum) run with the
+channels as lanes of structure-of-arrays state ([stage][channel]), so every step is one loop over the lanes that
+the compiler vectorizes. A channel on the normal output (with the default quadPhaseLFO = false) gives the same
+output as a mono PhaseShifter with the same parameters and the same modulation table setting.
+
+Audio I/O:
+- Processes planar blocks in[channel][sample] -> out[channel][sample], numChannels <= Channels, or interleaved
+  frames through processAudioFrame( ); processAudioSample( ) runs channel 0 only.
+
+Control I/F:
+- Use PhaseShifterParameters structure to get/set object params; modulationInterval > 1 evaluates the LFO and
+  the designs once per interval and interpolates the coefficients in between, as in PhaseShifter
+- setChannelLFOOutput( ) selects the LFO output of a channel; with quadPhaseLFO = true the channels on kNormal
+  use kQuadPhasePos, as the mono object does
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include "IAudioSignalProcessor.h"
+#include "EnumsAndStructs.h"
+#include "Constants.h"
+#include "AudioFilter.h"
+#include "helperfunctions.h"
+#include "Lfo.h"
+#include "PhaseShifter.h"
+
+namespace fxobjects
+{
+	template <uint32_t Channels, typename SampleType = double>
+	class MultichannelPhaseShifter : public IAudioSignalProcessor
+	{
+		static_assert(Channels > 0, "MultichannelPhaseShifter needs at least one channel");
+
+	public:
+		MultichannelPhaseShifter()
+		{
+			OscillatorParameters lfoparams = lfo.getParameters();
+			lfoparams.waveform = generatorWaveform::kTriangle;	// kTriangle LFO for phaser
+			lfoparams.amplitude_fac = 1.0;
+			lfo.setParameters(lfoparams);
+
+			for (uint32_t channel = 0; channel < Channels; channel++)
+				channelOutput[channel] = lfoOutput::kNormal;
+		}	/* C-TOR */
+
+		~MultichannelPhaseShifter() {}	/* D-TOR */
+
+		/** reset members to initialized state */
+		virtual bool reset(double _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			lfo.reset(_sampleRate);
+
+			// --- (re)build the modulation table for this sample rate
+			if (useModulationTable)
+				modulationTable.build(_sampleRate);
+
+			for (uint32_t stage = 0; stage < PHASER_STAGES; stage++)
+			{
+				for (uint32_t lane = 0; lane < Channels; lane++)
+					z1[stage][lane] = 0.0;
+			}
+
+			// --- the next sample sets the APFs directly
+			modulationCountdown = 0;
+			return true;
+		}
+
+		/** return true: this object also processes interleaved frames */
+		virtual bool canProcessAudioFrame() { return true; }
+
+		/** number of channels this object can process at once */
+		static constexpr uint32_t getNumChannels() { return Channels; }
+
+		/** process channel 0 only; the LFO advances for all channels */
+		virtual double processAudioSample(double xn)
+		{
+			SampleType x = (SampleType)xn;
+			SampleType y = 0.0;
+			const SampleType* in = &x;
+			SampleType* out = &y;
+			processBlockT(&in, &out, 1, 1);
+			return y;
+		}
+
+		/** process channel 0 only, block version */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(&in, &out, 1, n); }
+
+		/** process channel 0 only, block version, double precision */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(&in, &out, 1, n); }
+
+		/** process a planar block of numChannels (<= Channels) channels */
+		/**
+		\param in array of numChannels input buffers
+		\param out array of numChannels output buffers (may be the same buffers as in)
+		\param numChannels number of channels
+		\param n number of samples per channel
+		*/
+		void processBlock(const float* const* in, float* const* out, uint32_t numChannels, uint32_t n) { processBlockT(in, out, numChannels, n); }
+
+		/** process a planar block, double precision version */
+		void processBlock(const double* const* in, double* const* out, uint32_t numChannels, uint32_t n) { processBlockT(in, out, numChannels, n); }
+
+		/** process one interleaved frame; a mono input feeds every output channel */
+		virtual bool processAudioFrame(const float* inputFrame, float* outputFrame, uint32_t inputChannels, uint32_t outputChannels)
+		{
+			if (inputChannels == 0 || outputChannels == 0)
+				return false;
+
+			uint32_t numChannels = outputChannels < Channels ? outputChannels : Channels;
+			SampleType x[Channels];
+			SampleType y[Channels];
+			const SampleType* in[Channels];
+			SampleType* out[Channels];
+			for (uint32_t channel = 0; channel < numChannels; channel++)
+			{
+				x[channel] = channel < inputChannels ? inputFrame[channel] : inputFrame[0];
+				in[channel] = &x[channel];
+				out[channel] = &y[channel];
+			}
+
+			processBlockT(in, out, numChannels, 1);
+
+			for (uint32_t channel = 0; channel < numChannels; channel++)
+				outputFrame[channel] = (float)y[channel];
+			return true;
+		}
+
+		/** get parameters: note use of custom structure for passing param data */
+		/**
+		\return PhaseShifterParameters custom data structure
+		*/
+		PhaseShifterParameters getParameters() { return parameters; }
+
+		/** set parameters: note use of custom structure for passing param data */
+		/**
+		\param PhaseShifterParameters custom data structure
+		*/
+		void setParameters(const PhaseShifterParameters& params)
+		{
+			// --- update LFO rate
+			if (params.lfoRate_Hz != parameters.lfoRate_Hz || params.lfoAmplitude_fac != parameters.lfoAmplitude_fac)
+			{
+				OscillatorParameters lfoparams = lfo.getParameters();
+				lfoparams.frequency_Hz = params.lfoRate_Hz;
+				lfoparams.amplitude_fac = params.lfoAmplitude_fac;
+				lfo.setParameters(lfoparams);
+			}
+
+			// --- a new interval or LFO routing starts with a direct update
+			if (params.modulationInterval != parameters.modulationInterval || params.quadPhaseLFO != parameters.quadPhaseLFO)
+				modulationCountdown = 0;
+
+			// --- save new
+			parameters = params;
+		}
+
+		/** select the LFO output that modulates a channel */
+		/**
+		\param channel channel index
+		\param output one of the four LFO outputs
+		*/
+		void setChannelLFOOutput(uint32_t channel, lfoOutput output)
+		{
+			if (channel >= Channels || channelOutput[channel] == output)
+				return;
+
+			channelOutput[channel] = output;
+			modulationCountdown = 0;
+		}
+
+		/** get the LFO output of a channel */
+		lfoOutput getChannelLFOOutput(uint32_t channel) { return channel < Channels ? channelOutput[channel] : lfoOutput::kNormal; }
+
+		/** look the APF designs up in a PhaserModulationTable (the default) or run the design equations, as in
+			PhaseShifter; the table is built here if needed, so do NOT call from realtime audio thread */
+		/**
+		\param enable true to use the table
+		*/
+		void setModulationTableEnabled(bool enable)
+		{
+			useModulationTable = enable;
+			if (useModulationTable && sampleRate > 0.0)
+				modulationTable.build(sampleRate);
+		}
+
+		/** true if the APF designs come from the modulation table */
+		bool getModulationTableEnabled() { return useModulationTable; }
+
+	protected:
+		static constexpr uint32_t kNumLFOOutputs = 4;
+
+		PhaseShifterParameters parameters;	///< the object parameters
+		LFO lfo;							///< the one LFO shared by all channels
+		double sampleRate = 44100.0;		///< current sample rate
+		lfoOutput channelOutput[Channels];	///< LFO output per channel
+		uint32_t modulationCountdown = 0;	///< samples until the next LFO/APF update; 0 = update directly
+		bool useModulationTable = true;		///< APF designs from modulationTable
+		PhaserModulationTable<PHASER_STAGES> modulationTable;	///< G values over the modulator range at sampleRate
+
+		// --- per stage and lane: the first order APF has a0 = b1 = alpha, a1 = 1, so alpha is also its G value
+		alignas(64) SampleType alpha[PHASER_STAGES][Channels] = {};		///< current coefficient
+		alignas(64) SampleType increment[PHASER_STAGES][Channels] = {};	///< per-sample step towards the target
+		alignas(64) SampleType z1[PHASER_STAGES][Channels] = {};		///< state register, also the S value
+		double target[PHASER_STAGES][Channels] = {};					///< coefficient at the end of the interval
+
+		/** render the LFO and design the APFs for each LFO output in use, then load each lane from its output's
+			design: directly every sample (or after a reset), otherwise as a linear ramp over the interval */
+		/**
+		\param outputsMask the LFO outputs in use, from getOutputsInUse( )
+		*/
+		void updateModulation(uint32_t outputsMask)
+		{
+			if (modulationCountdown > 1)
+			{
+				modulationCountdown--;
+				for (uint32_t stage = 0; stage < PHASER_STAGES; stage++)
+				{
+					for (uint32_t lane = 0; lane < Channels; lane++)
+						alpha[stage][lane] += increment[stage][lane];
+				}
+				return;
+			}
+
+			const uint32_t interval = parameters.modulationInterval;
+			const bool ramp = interval > 1 && modulationCountdown == 1;
+			modulationCountdown = interval;
+
+			if (interval > 1)
+				lfo.skipSamples(interval - 1);
+			double lfoData[kNumLFOOutputs] = { 0.0, 0.0, 0.0, 0.0 };
+			double* lfoValue[kNumLFOOutputs] = { &lfoData[0], &lfoData[1], &lfoData[2], &lfoData[3] };
+			lfo.renderBlock(1, outputsMask, lfoValue[0], lfoValue[1], lfoValue[2], lfoValue[3]);
+
+			setModulation(lfoValue, 0, ramp, interval);
+		}
+
+		/** design the APFs once per LFO output in use and load each lane from its output's design, directly or as
+			a ramp over interval samples */
+		/**
+		\param lfoValue one array of LFO values per LFO output; only the outputs in use are read
+		\param index index of the values to use
+		\param ramp true to ramp to the designs
+		\param interval ramp length in samples
+		*/
+		void setModulation(const double* const* lfoValue, uint32_t index, bool ramp, uint32_t interval)
+		{
+			// --- one design per LFO output in use
+			const double depth = parameters.lfoDepth_Pct / 100.0;
+			double designedAlpha[kNumLFOOutputs][PHASER_STAGES];
+			bool designed[kNumLFOOutputs] = { false, false, false, false };
+
+			for (uint32_t lane = 0; lane < Channels; lane++)
+			{
+				uint32_t output = getLaneOutput(lane);
+				if (!designed[output])
+				{
+					if (useModulationTable && modulationTable.isBuilt())
+						modulationTable.lookup(lfoValue[output][index]*depth, designedAlpha[output]);
+					else
+						PhaserModulationTable<PHASER_STAGES>::designStages(lfoValue[output][index]*depth, sampleRate, designedAlpha[output]);
+					designed[output] = true;
+				}
+
+				for (uint32_t stage = 0; stage < PHASER_STAGES; stage++)
+				{
+					// --- the previous ramp lands exactly on its target
+					double next = designedAlpha[output][stage];
+					double current = ramp ? target[stage][lane] : next;
+					target[stage][lane] = next;
+					alpha[stage][lane] = (SampleType)current;
+					increment[stage][lane] = ramp ? (SampleType)((next - current) / interval) : (SampleType)0.0;
+					if (ramp)
+						alpha[stage][lane] += increment[stage][lane];
+				}
+			}
+		}
+
+		/** lfoOutputBit( ) mask of the LFO outputs the lanes use */
+		uint32_t getOutputsInUse()
+		{
+			uint32_t outputsMask = 0;
+			for (uint32_t lane = 0; lane < Channels; lane++)
+				outputsMask |= lfoOutputBit((lfoOutput)getLaneOutput(lane));
+			return outputsMask;
+		}
+
+		/** index of the LFO output for a lane, after the quadPhaseLFO swap */
+		uint32_t getLaneOutput(uint32_t lane)
+		{
+			if (parameters.quadPhaseLFO && channelOutput[lane] == lfoOutput::kNormal)
+				return (uint32_t)lfoOutput::kQuadPhasePos;
+			return (uint32_t)channelOutput[lane];
+		}
+
+		/** block worker: per sample, each step of the phaser is one loop over the lanes */
+		template <typename BufferType>
+		void processBlockT(const BufferType* const* in, BufferType* const* out, uint32_t numChannels, uint32_t n)
+		{
+			if (numChannels > Channels)
+				numChannels = Channels;
+
+			const SampleType K = (SampleType)(parameters.intensity_Pct / 100.0);
+			alignas(64) SampleType x[Channels] = {};
+			alignas(64) SampleType u[Channels];
+			alignas(64) SampleType Sn[Channels];
+			alignas(64) SampleType weight[Channels];
+
+			// --- modulating every sample, the LFO renders a scratch block of the outputs in use at a time
+			const uint32_t outputsMask = getOutputsInUse();
+			const bool everySample = parameters.modulationInterval == 1;
+			double lfoBlock[kNumLFOOutputs][BLOCK_SCRATCH_LENGTH];
+			const double* lfoValue[kNumLFOOutputs] = { lfoBlock[0], lfoBlock[1], lfoBlock[2], lfoBlock[3] };
+
+			for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+			{
+				uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+				if (everySample)
+					lfo.renderBlock(count, outputsMask, lfoBlock[0], lfoBlock[1], lfoBlock[2], lfoBlock[3]);
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					const uint32_t s = offset + i;
+
+					// --- LFO and APF coefficients, every sample or once per modulation interval
+					if (everySample)
+						setModulation(lfoValue, i, false, 1);
+					else
+						updateModulation(outputsMask);
+
+					for (uint32_t lane = 0; lane < numChannels; lane++)
+						x[lane] = (SampleType)in[lane][s];
+
+					// --- gamma values, weight(i) = G(i+1)*G(i+2)*...*G(last), built from the last stage down; the
+					//     feedback sum is accumulated in stage order, as in PhaseShifter, from the stored products
+					SampleType stageWeight[PHASER_STAGES][Channels];
+					for (uint32_t lane = 0; lane < Channels; lane++)
+						weight[lane] = 1.0;
+					for (uint32_t stage = PHASER_STAGES; stage-- > 0;)
+					{
+						for (uint32_t lane = 0; lane < Channels; lane++)
+						{
+							stageWeight[stage][lane] = weight[lane];
+							weight[lane] *= alpha[stage][lane];
+						}
+					}
+
+					// --- combined feedback and input to the first APF
+					for (uint32_t lane = 0; lane < Channels; lane++)
+						Sn[lane] = 0.0;
+					for (uint32_t stage = 0; stage < PHASER_STAGES; stage++)
+					{
+						for (uint32_t lane = 0; lane < Channels; lane++)
+							Sn[lane] += stageWeight[stage][lane]*z1[stage][lane];
+					}
+					for (uint32_t lane = 0; lane < Channels; lane++)
+						u[lane] = ((SampleType)1.0 / ((SampleType)1.0 + K*weight[lane]))*(x[lane] + K*Sn[lane]);
+
+					// --- cascade of APFs, transposed canonical: y = alpha*u + z1, z1 = u - alpha*y
+					for (uint32_t stage = 0; stage < PHASER_STAGES; stage++)
+					{
+						for (uint32_t lane = 0; lane < Channels; lane++)
+						{
+							SampleType yn = alpha[stage][lane]*u[lane] + z1[stage][lane];
+#ifndef FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE
+							yn = std::fabs(yn) < (SampleType)kSmallestPositiveFloatValue ? (SampleType)0.0 : yn;
+#endif
+							z1[stage][lane] = u[lane] - alpha[stage][lane]*yn;
+							u[lane] = yn;
+						}
+					}
+
+					for (uint32_t lane = 0; lane < numChannels; lane++)
+						out[lane][s] = (BufferType)((SampleType)0.125*x[lane] + (SampleType)1.25*u[lane]);
+				}
+			}
+
+			if (everySample)
+				modulationCountdown = 1;
+		}
+	};
+} // namespace fxobjects
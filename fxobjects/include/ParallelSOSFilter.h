@@ -0,0 +1,163 @@
+/**
+\class ParallelSOSFilter
+\ingroup FX-Objects
+\brief
+The ParallelSOSFilter object runs a high order IIR filter as a sum of parallel second order sections instead of
+a cascade: cascadeToParallel( ) expands the cascade in partial fractions, and the sections run side by side in
+a BiquadBank, one filter per SIMD lane, with the outputs summed. A cascade is a chain of dependent sections;
+the parallel form has no dependency between sections, so an 8th - 16th order filter costs about one bank tick
+per sample.
+
+The expansion is the delayed form H(z) = Q(z^-1) + sum g*z^-1/(1 - p*z^-1) (one term per pole p, conjugate
+and real pairs combined into real sections): its numerators stay bounded when a pole is near the origin, and the
+direct term Q is the first impulse response sample plus one or two delays for poles at the origin. Q runs as
+one more lane of the bank with b1 = b2 = 0.
+
+The poles of the cascade must be distinct: repeated poles (e.g. a Linkwitz-Riley filter, which is a squared
+Butterworth) have no parallel second order form, and cascadeToParallel( ) rejects them. Closely spaced poles
+give large, cancelling section gains, so prefer SampleType = double for narrow or very high order filters.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setCascade( ) from { a0, a1, a2, b1, b2, c0, d0 } arrays, e.g. FilterDesigner::designFilter( ) or a set of
+  AudioFilter::getCoefficients( ); setFilterDesign( ) to design and load in one call (not from the realtime thread)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include "IAudioSignalProcessor.h"
+#include "EnumsAndStructs.h"
+#include "Constants.h"
+#include "BiquadBank.h"
+#include "FilterDesigner.h"
+
+namespace fxobjects
+{
+	/**
+	@cascadeToParallel
+	\ingroup FX-Functions
+
+	@brief partial fraction expansion of a cascade of second order sections into parallel sections; the sum of
+	the parallel sections' outputs equals the cascade output. Allocates.
+
+	\param cascadeCoeffs numSections { a0, a1, a2, b1, b2, c0, d0 } arrays back to back; the output
+	d0*x(n) + c0*y(n) of each section is folded in, as in BiquadCascade
+	\param numSections number of cascade sections
+	\param parallelCoeffs receives numParallelSections arrays, at most numSections + 1; the last one is the direct
+	term (b1 = b2 = 0)
+	\param numParallelSections receives the number of parallel sections
+	\return false for repeated poles, more than two poles at the origin or numSections = 0; parallelCoeffs is untouched
+	*/
+	bool cascadeToParallel(const double* cascadeCoeffs, uint32_t numSections, double* parallelCoeffs, uint32_t& numParallelSections);
+
+	template <typename SampleType = float>
+	class ParallelSOSFilter : public IAudioSignalProcessor
+	{
+	public:
+		ParallelSOSFilter() {}		/* C-TOR */
+		~ParallelSOSFilter() {}		/* D-TOR */
+
+		// --- IAudioSignalProcessor
+		/** reset: flush all section states; the sample rate is stored for setFilterDesign( ) */
+		virtual bool reset(double _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			return bank.reset(_sampleRate);
+		}
+
+		/** return false: this object only processes samples */
+		virtual bool canProcessAudioFrame() { return false; }
+
+		/** set the sample rate used by setFilterDesign( ); does not redesign the current filter */
+		virtual void setSampleRate(double _sampleRate) { sampleRate = _sampleRate; }
+
+		/** convert a cascade and load it, clearing the state; do NOT call from realtime audio thread */
+		/**
+		\param cascadeCoeffs numSections { a0, a1, a2, b1, b2, c0, d0 } arrays back to back
+		\param numSections number of cascade sections
+		\return false if cascadeToParallel( ) rejects the cascade; the filter is unchanged
+		*/
+		bool setCascade(const double* cascadeCoeffs, uint32_t numSections)
+		{
+			if (numSections == 0)
+				return false;
+
+			std::unique_ptr<double[]> parallelCoeffs(new double[(numSections + 1) * numCoeffs]);
+			uint32_t numParallelSections = 0;
+			if (!cascadeToParallel(cascadeCoeffs, numSections, parallelCoeffs.get(), numParallelSections))
+				return false;
+
+			bank.setNumFilters(numParallelSections);
+			bank.reset(sampleRate);
+			for (uint32_t section = 0; section < numParallelSections; section++)
+				bank.setCoefficients(section, &parallelCoeffs[section * numCoeffs]);
+			return true;
+		}
+
+		/** design a high order filter with FilterDesigner at the current sample rate and load it in parallel
+			form; do NOT call from realtime audio thread */
+		/**
+		\param parameters design parameters
+		\return false if the design or the conversion fails; the filter is unchanged
+		*/
+		bool setFilterDesign(const FilterDesignParameters& parameters)
+		{
+			uint32_t numSections = FilterDesigner::getNumSections(parameters);
+			std::unique_ptr<double[]> cascadeCoeffs(new double[numSections * numCoeffs]);
+			if (!FilterDesigner::designFilter(parameters, sampleRate, cascadeCoeffs.get()))
+				return false;
+
+			return setCascade(cascadeCoeffs.get(), numSections);
+		}
+
+		/** get the number of parallel sections, including the direct term */
+		uint32_t getNumSections() { return bank.getNumFilters(); }
+
+		/** process input x(n) through all sections and return the sum */
+		virtual double processAudioSample(double xn)
+		{
+			SampleType x = (SampleType)xn;
+			SampleType y = 0.0;
+			bank.processBlockSum(&x, &y, 1);
+			return y;
+		}
+
+		/** process a block through all sections */
+		virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+		/** process a block through all sections, double precision version */
+		virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
+	protected:
+		BiquadBank<SampleType> bank;	///< the parallel sections, one per lane
+		double sampleRate = 44100.0;	///< sample rate for setFilterDesign( )
+
+		/** block worker; converts through a scratch buffer when the buffer type is not SampleType */
+		template <typename BufferType>
+		void processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+		{
+			if constexpr (std::is_same<BufferType, SampleType>::value)
+				bank.processBlockSum(in, out, n);
+			else
+			{
+				SampleType buffer[BLOCK_SCRATCH_LENGTH];
+				for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+				{
+					uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+					for (uint32_t i = 0; i < count; i++)
+						buffer[i] = (SampleType)in[offset + i];
+
+					bank.processBlockSum(buffer, buffer, count);
+
+					for (uint32_t i = 0; i < count; i++)
+						out[offset + i] = (BufferType)buffer[i];
+				}
+			}
+		}
+	};
+} // namespace fxobjects
@@ -63,6 +63,12 @@ namespace fxobjects {
             return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
         }
     
+        /** process a block: the detector runs on the whole chunk, the makeup gain is converted once per block */
+        virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+    
+        /** process a block, double precision version */
+        virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+    
         /** compute the gain reduction value based on detected value in dB */
         double computeGain(double detect_dB)
         {
@@ -107,6 +113,28 @@ namespace fxobjects {
         void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; }
     
     protected:
+        /** block worker, shared by the float and double overrides */
+        template <typename SampleType>
+        void processBlockT(const SampleType* in, SampleType* out, uint32_t n)
+        {
+            const double makeUpGain = dB2Raw(makeUpGain_dB);
+            double detectBuffer[BLOCK_SCRATCH_LENGTH];
+            double xBuffer[BLOCK_SCRATCH_LENGTH];
+    
+            // --- chunks keep the input alive for in-place processing
+            for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+            {
+                uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+                for (uint32_t i = 0; i < count; i++)
+                    xBuffer[i] = in[offset + i];
+    
+                detector.processBlock(xBuffer, detectBuffer, count);
+    
+                for (uint32_t i = 0; i < count; i++)
+                    out[offset + i] = (SampleType)(makeUpGain*xBuffer[i]*computeGain(detectBuffer[i]));
+            }
+        }
+    
         AudioDetector detector;		///< the detector object
         double threshold_dB = 0.0;	///< stored threshold (dB)
         double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
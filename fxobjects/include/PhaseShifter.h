@@ -1,14 +1,26 @@
 /**
-\class PhaseShifter
+\class PhaseShifterN
 \ingroup FX-Objects
 \brief
-The PhaseShifter object implements a six-stage phaser.
+The PhaseShifterN object implements a phaser with Stages first order APFs (4, 6, 8 or 12) in a feedback loop;
+PhaseShifter is the six-stage PhaseShifterN<PHASER_STAGES>. The modulation range of each stage comes from
+PhaserStageRanges<Stages>.
+
+The APFs are kept as contiguous per-stage arrays rather than AudioFilter objects: the G value of a first order
+APF is its coefficient alpha (a0 = b1 = alpha, a1 = 1) and its S value is its state register, so the delay-free
+loop resolution is a suffix product over the G array (weight(i) = G(i+1)*...*G(last)) and a dot product of the
+weights with the S array, with no per-stage calls. The products and the sum run in stage order, so the six
+stage object with the modulation table disabled gives the same output as the original PhaseShifter.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use BiquadParameters structure to get/set object params.
+- Use PhaseShifterParameters structure to get/set object params.
+- modulationInterval > 1 selects control rate modulation: the LFO and the APF designs are evaluated once per
+  interval (e.g. 16 - 64 samples) and the APF coefficients are interpolated in between.
+- by default the APF designs are interpolated from a PhaserModulationTable built at reset( ), so there is no
+  trigonometry per update; setModulationTableEnabled(false) runs the exact design equations instead.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
@@ -17,6 +29,7 @@ Control I/F:
 */
 
 #pragma once
+#include <memory>
 #include "IAudioSignalProcessor.h"
 #include "AudioFilter.h"
 #include "helperfunctions.h"
@@ -25,43 +38,178 @@ Control I/F:
 
 namespace fxobjects
 {
-    class PhaseShifter : public IAudioSignalProcessor
+    /**
+    \struct PhaserStageRanges
+    \ingroup Constants-Enums
+    \brief
+    Modulation range { minF, maxF } in Hz of each APF stage, lowest stage first, for the supported phaser depths.
+    The six-stage table is the National Semiconductor design (the apfN_minF/apfN_maxF constants); the others
+    spread the same 32 Hz - 20.48 kHz span over fewer or more stages.
+    */
+    template <uint32_t Stages>
+    struct PhaserStageRanges;
+
+    template <>
+    struct PhaserStageRanges<4>
+    {
+        static constexpr double minF[4] = { 32.0, 96.0, 212.0, 636.0 };
+        static constexpr double maxF[4] = { 1500.0, 4800.0, 10000.0, 20480.0 };
+    };
+
+    template <>
+    struct PhaserStageRanges<6>
+    {
+        static constexpr double minF[6] = { apf0_minF, apf1_minF, apf2_minF, apf3_minF, apf4_minF, apf5_minF };
+        static constexpr double maxF[6] = { apf0_maxF, apf1_maxF, apf2_maxF, apf3_maxF, apf4_maxF, apf5_maxF };
+    };
+
+    template <>
+    struct PhaserStageRanges<8>
+    {
+        static constexpr double minF[8] = { 32.0, 48.0, 68.0, 96.0, 150.0, 212.0, 320.0, 636.0 };
+        static constexpr double maxF[8] = { 1500.0, 2300.0, 3400.0, 4800.0, 7000.0, 10000.0, 16000.0, 20480.0 };
+    };
+
+    template <>
+    struct PhaserStageRanges<12>
+    {
+        static constexpr double minF[12] = { 32.0, 40.0, 48.0, 58.0, 68.0, 82.0, 96.0, 150.0, 212.0, 320.0, 450.0, 636.0 };
+        static constexpr double maxF[12] = { 1500.0, 1900.0, 2300.0, 2800.0, 3400.0, 4100.0, 4800.0, 7000.0, 10000.0, 13000.0, 16000.0, 20480.0 };
+    };
+
+    /**
+    \class PhaserModulationTable
+    \ingroup FX-Objects
+    \brief
+    The G values (first order APF coefficients) of every phaser stage as a function of the bipolar modulator
+    value: each stage's fc is doBipolarModulation( ) of the modulator over its PhaserStageRanges entry, so for a
+    given sample rate the whole design is a function of one number. build( ) tabulates it over [-1, +1] with
+    kTableLength intervals, stored [point][stage] so a lookup interpolates one contiguous row pair; the error is
+    below 1e-6 of the exact design, which designStages( ) still gives.
+    */
+    template <uint32_t Stages>
+    class PhaserModulationTable
     {
     public:
-        PhaseShifter(void) {
+        static constexpr uint32_t kTableLength = 1024;	///< intervals over the modulator range [-1, +1]
+
+        /** the exact G values of all stages for a modulator value */
+        /**
+        \param modulatorValue bipolar modulator, bounded to [-1, +1]
+        \param sampleRate sample rate
+        \param G receives Stages G values
+        */
+        static void designStages(double modulatorValue, double sampleRate, double* G)
+        {
+            AudioFilterParameters params;
+            params.algorithm = filterAlgorithm::kAPF1;
+            double coeffs[numCoeffs] = { 0.0 };
+            for (uint32_t i = 0; i < Stages; i++)
+            {
+                params.fc = doBipolarModulation(modulatorValue, PhaserStageRanges<Stages>::minF[i], PhaserStageRanges<Stages>::maxF[i]);
+                AudioFilter::calculateFilterCoeffs(params, sampleRate, coeffs);
+                G[i] = coeffs[a0];
+            }
+        }
+
+        /** tabulate the design at a sample rate; allocates the first time, so do NOT call from realtime audio thread */
+        void build(double _sampleRate)
+        {
+            if (table && sampleRate == _sampleRate)
+                return;
+
+            if (!table)
+                table.reset(new double[(kTableLength + 1) * Stages]);
+            sampleRate = _sampleRate;
+
+            for (uint32_t point = 0; point <= kTableLength; point++)
+                designStages(2.0 * point / kTableLength - 1.0, sampleRate, &table[point * Stages]);
+        }
+
+        /** true once build( ) has run */
+        bool isBuilt() const { return table != nullptr; }
+
+        /** interpolated G values of all stages for a modulator value */
+        /**
+        \param modulatorValue bipolar modulator, bounded to [-1, +1]
+        \param G receives Stages G values
+        */
+        inline void lookup(double modulatorValue, double* G) const
+        {
+            boundValue(modulatorValue, -1.0, 1.0);
+            double position = (modulatorValue + 1.0) * (0.5 * kTableLength);
+            uint32_t index = (uint32_t)position;
+            if (index >= kTableLength)
+                index = kTableLength - 1;
+            double fraction = position - index;
+
+            const double* row = &table[index * Stages];
+            for (uint32_t i = 0; i < Stages; i++)
+                G[i] = row[i] + fraction * (row[Stages + i] - row[i]);
+        }
+
+    protected:
+        std::unique_ptr<double[]> table = nullptr;	///< (kTableLength + 1) x Stages G values
+        double sampleRate = 0.0;					///< sample rate of the table
+    };
+
+    template <uint32_t Stages>
+    class PhaseShifterN : public IAudioSignalProcessor
+    {
+        static_assert(Stages == 4 || Stages == 6 || Stages == 8 || Stages == 12, "PhaseShifterN supports 4, 6, 8 or 12 stages");
+
+    public:
+        PhaseShifterN(void) {
             OscillatorParameters lfoparams = lfo.getParameters();
             lfoparams.waveform = generatorWaveform::kTriangle;	// kTriangle LFO for phaser
         //	lfoparams.waveform = generatorWaveform::kSin;		// kTriangle LFO for phaser
             lfoparams.amplitude_fac = 1.0;
             lfo.setParameters(lfoparams);
-    
-            AudioFilterParameters params = apf[0].getParameters();
-            params.algorithm = filterAlgorithm::kAPF1; // can also use 2nd order
-            // params.Q = 0.001; use low Q if using 2nd order APFs
-    
-            for (uint32_t i = 0; i < PHASER_STAGES; i++)
-            {
-                apf[i].setParameters(params);
-            }
         }	/* C-TOR */
-    
-        ~PhaseShifter(void) {}	/* D-TOR */
-    
+
+        ~PhaseShifterN(void) {}	/* D-TOR */
+
     public:
         /** reset members to initialized state */
         virtual bool reset(double _sampleRate)
         {
+            sampleRate = _sampleRate;
+
             // --- reset LFO
             lfo.reset(_sampleRate);
-    
+
             // --- reset APFs
-            for (uint32_t i = 0; i < PHASER_STAGES; i++){
-                apf[i].reset(_sampleRate);
-            }
-    
+            for (uint32_t i = 0; i < Stages; i++)
+                S[i] = 0.0;
+
+            // --- (re)build the modulation table for this sample rate
+            if (useModulationTable)
+                modulationTable.build(_sampleRate);
+
+            // --- the next sample sets the APFs directly
+            modulationCountdown = 0;
             return true;
         }
-    
+
+        /** number of APF stages */
+        static constexpr uint32_t getNumStages() { return Stages; }
+
+        /** look the G values up in a PhaserModulationTable built at reset( ) (the default) instead of running the
+            design equations for every update; the table is built here if needed, so do NOT call from realtime
+            audio thread */
+        /**
+        \param enable true to use the table
+        */
+        void setModulationTableEnabled(bool enable)
+        {
+            useModulationTable = enable;
+            if (useModulationTable && sampleRate > 0.0)
+                modulationTable.build(sampleRate);
+        }
+
+        /** true if the G values come from the modulation table */
+        bool getModulationTableEnabled() { return useModulationTable; }
+
         /** process autio through phaser */
         /**
         \param xn input
@@ -69,88 +217,27 @@ namespace fxobjects
         */
         virtual double processAudioSample(double xn)
         {
-            SignalGenData lfoData = lfo.renderAudioOutput();
-    
-            // --- create the bipolar modulator value
-            double lfoValue = lfoData.normalOutput;
-            if (parameters.quadPhaseLFO)
-                lfoValue = lfoData.quadPhaseOutput_pos;
-    
-            double depth = parameters.lfoDepth_Pct / 100.0;
-            double modulatorValue = lfoValue*depth;
-    
-            // --- calculate modulated values for each APF; note they have different ranges
-            AudioFilterParameters params = apf[0].getParameters();
-            params.fc = doBipolarModulation(modulatorValue, apf0_minF, apf0_maxF);
-            apf[0].setParameters(params);
-    
-            params = apf[1].getParameters();
-            params.fc = doBipolarModulation(modulatorValue, apf1_minF, apf1_maxF);
-            apf[1].setParameters(params);
-    
-            params = apf[2].getParameters();
-            params.fc = doBipolarModulation(modulatorValue, apf2_minF, apf2_maxF);
-            apf[2].setParameters(params);
-    
-            params = apf[3].getParameters();
-            params.fc = doBipolarModulation(modulatorValue, apf3_minF, apf3_maxF);
-            apf[3].setParameters(params);
-    
-            params = apf[4].getParameters();
-            params.fc = doBipolarModulation(modulatorValue, apf4_minF, apf4_maxF);
-            apf[4].setParameters(params);
-    
-            params = apf[5].getParameters();
-            params.fc = doBipolarModulation(modulatorValue, apf5_minF, apf5_maxF);
-            apf[5].setParameters(params);
-    
-            // --- calculate gamma values
-            double gamma1 = apf[5].getG_value();
-            double gamma2 = apf[4].getG_value() * gamma1;
-            double gamma3 = apf[3].getG_value() * gamma2;
-            double gamma4 = apf[2].getG_value() * gamma3;
-            double gamma5 = apf[1].getG_value() * gamma4;
-            double gamma6 = apf[0].getG_value() * gamma5;
-    
-            // --- set the alpha0 value
-            double K = parameters.intensity_Pct / 100.0;
-            double alpha0 = 1.0 / (1.0 + K*gamma6);
-    
-            // --- create combined feedback
-            double Sn = gamma5*apf[0].getS_value() + gamma4*apf[1].getS_value() + gamma3*apf[2].getS_value() + gamma2*apf[3].getS_value() + gamma1*apf[4].getS_value() + apf[5].getS_value();
-    
-            // --- form input to first APF
-            double u = alpha0*(xn + K*Sn);
-    
-            // --- cascade of APFs (could also nest these in one massive line of code)
-            double APF1 = apf[0].processAudioSample(u);
-            double APF2 = apf[1].processAudioSample(APF1);
-            double APF3 = apf[2].processAudioSample(APF2);
-            double APF4 = apf[3].processAudioSample(APF3);
-            double APF5 = apf[4].processAudioSample(APF4);
-            double APF6 = apf[5].processAudioSample(APF5);
-    
-            // --- sum with -3dB coefficients
-            //	double output = 0.707*xn + 0.707*APF6;
-    
-            // --- sum with National Semiconductor design ratio:
-            //	   dry = 0.5, wet = 5.0
-            // double output = 0.5*xn + 5.0*APF6;
-            // double output = 0.25*xn + 2.5*APF6;
-            double output = 0.125*xn + 1.25*APF6;
-    
-            return output;
+            // --- LFO and APF frequencies, every sample or once per modulation interval
+            updateModulation(parameters.lfoDepth_Pct / 100.0, parameters.quadPhaseLFO);
+
+            return processSample(xn, parameters.intensity_Pct / 100.0);
         }
-    
+
+        /** process a block through the phaser; depth, intensity and LFO output selection are decoded once per block */
+        virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+        /** process a block through the phaser, double precision version */
+        virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
         /** return false: this object only processes samples */
         virtual bool canProcessAudioFrame() { return false; }
-    
+
         /** get parameters: note use of custom structure for passing param data */
         /**
         \return PhaseShifterParameters custom data structure
         */
         PhaseShifterParameters getParameters() { return parameters; }
-    
+
         /** set parameters: note use of custom structure for passing param data */
         /**
         \param PhaseShifterParameters custom data structure
@@ -165,13 +252,187 @@ namespace fxobjects
                 lfoparams.amplitude_fac = params.lfoAmplitude_fac;
                 lfo.setParameters(lfoparams);
             }
-    
+
+            // --- a new interval starts with a direct update
+            if (params.modulationInterval != parameters.modulationInterval)
+                modulationCountdown = 0;
+
             // --- save new
             parameters = params;
         }
     protected:
+        /** render the LFO and design the APFs for the next sample. With a modulation interval N > 1 this runs
+            once every N samples: the LFO skips ahead to the last sample of the interval and each APF coefficient
+            (and with it the G value) ramps linearly to that design over the interval, so the design equations
+            run once per interval instead of every sample */
+        void updateModulation(double depth, bool quadPhaseLFO)
+        {
+            if (modulationCountdown > 1)
+            {
+                modulationCountdown--;
+                for (uint32_t i = 0; i < Stages; i++)
+                    G[i] += increment[i];
+                return;
+            }
+            startModulationInterval(depth, quadPhaseLFO);
+        }
+
+        /** the once per interval part of updateModulation( ): render the LFO at the end of the interval and design
+            the APFs, kept out of line so the per-sample loops stay tight */
+        FXOBJECTS_NOINLINE void startModulationInterval(double depth, bool quadPhaseLFO)
+        {
+            // --- the first update after a reset or interval change is set directly
+            const uint32_t interval = parameters.modulationInterval;
+            const bool ramp = interval > 1 && modulationCountdown == 1;
+            modulationCountdown = interval;
+
+            if (interval > 1)
+                lfo.skipSamples(interval - 1);
+            double lfoValue = 0.0;
+            renderLFO(1, quadPhaseLFO, &lfoValue);
+
+            setModulation(lfoValue*depth, ramp, interval);
+        }
+
+        /** render the one LFO output the phaser uses into an array */
+        /**
+        \param n number of samples
+        \param quadPhaseLFO true for the +90 degree output, false for the normal output
+        \param lfoValue receives n LFO values
+        */
+        void renderLFO(uint32_t n, bool quadPhaseLFO, double* lfoValue)
+        {
+            if (quadPhaseLFO)
+                lfo.renderBlock(n, lfoOutputBit(lfoOutput::kQuadPhasePos), nullptr, nullptr, lfoValue);
+            else
+                lfo.renderBlock(n, lfoOutputBit(lfoOutput::kNormal), lfoValue);
+        }
+
+        /** design the APFs for a modulator value and load the G values directly, or ramp to them over interval
+            samples */
+        void setModulation(double modulatorValue, bool ramp, uint32_t interval)
+        {
+            // --- modulated G values for each APF (note they have different ranges), from the table or designed
+            double designed[Stages];
+            if (useModulationTable && modulationTable.isBuilt())
+                modulationTable.lookup(modulatorValue, designed);
+            else
+                PhaserModulationTable<Stages>::designStages(modulatorValue, sampleRate, designed);
+
+            for (uint32_t i = 0; i < Stages; i++)
+            {
+                // --- the previous ramp lands exactly on its target
+                double current = ramp ? target[i] : designed[i];
+                target[i] = designed[i];
+                increment[i] = ramp ? (designed[i] - current) / interval : 0.0;
+                G[i] = current + increment[i];
+            }
+        }
+
+        /** one sample through the loop and the APF cascade */
+        inline double processSample(double xn, double K)
+        {
+            // --- gamma values, weight[i] = G(i+1)*G(i+2)*...*G(last), a suffix product over the G array
+            double weight[Stages];
+            weight[Stages - 1] = 1.0;
+            for (uint32_t i = Stages - 1; i > 0; i--)
+                weight[i - 1] = G[i]*weight[i];
+            double gammaN = G[0]*weight[0];
+
+            // --- combined feedback: the dot product of the weights and the S values, summed in stage order
+            double product[Stages];
+            for (uint32_t i = 0; i < Stages; i++)
+                product[i] = weight[i]*S[i];
+            double Sn = 0.0;
+            for (uint32_t i = 0; i < Stages; i++)
+                Sn += product[i];
+
+            // --- form input to first APF
+            double u = (1.0 / (1.0 + K*gammaN))*(xn + K*Sn);
+
+            // --- cascade of APFs, transposed canonical: y = G*u + S, S = u - G*y
+            for (uint32_t i = 0; i < Stages; i++)
+            {
+                double yn = G[i]*u + S[i];
+                checkKernelUnderflow(yn);
+                S[i] = u - G[i]*yn;
+                u = yn;
+            }
+
+            // --- sum with -3dB coefficients
+            //	double output = 0.707*xn + 0.707*u;
+
+            // --- sum with National Semiconductor design ratio:
+            //	   dry = 0.5, wet = 5.0
+            // double output = 0.5*xn + 5.0*u;
+            // double output = 0.25*xn + 2.5*u;
+            return 0.125*xn + 1.25*u;
+        }
+
+        /** block worker, shared by the float and double overrides */
+        template <typename SampleType>
+        void processBlockT(const SampleType* in, SampleType* out, uint32_t n)
+        {
+            const double depth = parameters.lfoDepth_Pct / 100.0;
+            const double K = parameters.intensity_Pct / 100.0;
+            const bool quadPhaseLFO = parameters.quadPhaseLFO;
+
+            // --- once per modulation interval: LFO and APF frequencies as the interval comes up
+            if (parameters.modulationInterval > 1)
+            {
+                uint32_t s = 0;
+                while (s < n)
+                {
+                    // --- the first sample of an interval designs the APFs
+                    if (modulationCountdown <= 1)
+                    {
+                        startModulationInterval(depth, quadPhaseLFO);
+                        out[s] = (SampleType)processSample(in[s], K);
+                        s++;
+                    }
+
+                    // --- the rest of the interval (or of the block) only steps the G values along the ramp
+                    uint32_t count = modulationCountdown - 1 < n - s ? modulationCountdown - 1 : n - s;
+                    modulationCountdown -= count;
+                    for (uint32_t end = s + count; s < end; s++)
+                    {
+                        for (uint32_t i = 0; i < Stages; i++)
+                            G[i] += increment[i];
+                        out[s] = (SampleType)processSample(in[s], K);
+                    }
+                }
+                return;
+            }
+
+            // --- every sample: the LFO renders a scratch block at a time, then each sample sets its APFs directly
+            double lfoValue[BLOCK_SCRATCH_LENGTH];
+            for (uint32_t offset = 0; offset < n; offset += BLOCK_SCRATCH_LENGTH)
+            {
+                uint32_t count = n - offset < BLOCK_SCRATCH_LENGTH ? n - offset : BLOCK_SCRATCH_LENGTH;
+                renderLFO(count, quadPhaseLFO, lfoValue);
+
+                for (uint32_t s = 0; s < count; s++)
+                {
+                    setModulation(lfoValue[s]*depth, false, 1);
+                    out[offset + s] = (SampleType)processSample(in[offset + s], K);
+                }
+            }
+            modulationCountdown = 1;
+        }
+
         PhaseShifterParameters parameters;  ///< the object parameters
-        AudioFilter apf[PHASER_STAGES];		///< six APF objects
         LFO lfo;							///< the one and only LFO
+        double sampleRate = 44100.0;		///< current sample rate
+        uint32_t modulationCountdown = 0;	///< samples until the next LFO/APF update; 0 = update directly
+        bool useModulationTable = true;		///< G values from modulationTable
+        PhaserModulationTable<Stages> modulationTable;	///< G values over the modulator range at sampleRate
+
+        // --- first order APFs: G = alpha (a0 = b1 = alpha, a1 = 1), S = the state register
+        double G[Stages] = {};			///< APF coefficients, also the G values
+        double S[Stages] = {};			///< APF state registers, also the S values
+        double increment[Stages] = {};	///< per-sample coefficient step towards the target
+        double target[Stages] = {};		///< coefficients at the end of the interval
     };
+
+    using PhaseShifter = PhaseShifterN<PHASER_STAGES>;
 } // namespace fxobjects
@@ -21,19 +21,25 @@ Control I/F:
 #include "include/VAEnumsStructs.h"
 #include "include/helperfunctions.h"
 #include "include/PeakLimiter.h"
+#include "include/FastMath.h"
+#include "include/FrequencyResponse.h"
 
 using namespace fxobjects;
 
-class ZVAFilter : public IAudioSignalProcessor
+/** ZVAFilter with coefficients and integrator states in SampleType (float or double) precision;
+	ZVAFilter is BasicZVAFilter<double>. */
+template <typename SampleType = double>
+class BasicZVAFilter : public IAudioSignalProcessor
 {
 public:
-	ZVAFilter() {}		/* C-TOR */
-	~ZVAFilter() {}		/* D-TOR */
+	BasicZVAFilter() {}		/* C-TOR */
+	~BasicZVAFilter() {}		/* D-TOR */
 
-	/** reset members to initialized state */
+	/** reset members to initialized state; the coefficients follow the new sample rate */
 	virtual bool reset(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
+		coeffsDirty = true;
 		integrator_z[0] = 0.0;
 		integrator_z[1] = 0.0;
 
@@ -49,7 +55,8 @@ public:
 		return zvaFilterParameters;
 	}
 
-	/** set parameters: note use of custom structure for passing param data */
+	/** set parameters: note use of custom structure for passing param data; a change that affects the
+		coefficients only flags them, and they are recalculated once before the next sample or block */
 	/**
 	\param ZVAFilterParameters custom data structure
 	*/
@@ -57,14 +64,25 @@ public:
 	{
 		if (params.fc != zvaFilterParameters.fc ||
 			params.Q != zvaFilterParameters.Q ||
+			params.filterAlgorithm != zvaFilterParameters.filterAlgorithm ||
 			params.selfOscillate != zvaFilterParameters.selfOscillate ||
 			params.matchAnalogNyquistLPF != zvaFilterParameters.matchAnalogNyquistLPF)
-		{
-			zvaFilterParameters = params;
-			calculateFilterCoeffs();
-		}
-		else
-			zvaFilterParameters = params;
+			coeffsDirty = true;
+
+		zvaFilterParameters = params;
+	}
+
+	/** recalculate the coefficients now if they are out of date; processing calls this first */
+	/**
+	\return true if the coefficients were recalculated
+	*/
+	bool updateCoefficients()
+	{
+		if (!coeffsDirty)
+			return false;
+
+		calculateFilterCoeffs();
+		return true;
 	}
 
 	/** return false: this object only processes samples */
@@ -77,6 +95,9 @@ public:
 	*/
 	virtual double processAudioSample(double xn)
 	{
+		// --- parameter changes since the last sample
+		updateCoefficients();
+
 		// --- with gain comp enabled, we reduce the input by
 		//     half the gain in dB at resonant peak
 		//     NOTE: you can change that logic here!
@@ -93,16 +114,18 @@ public:
 			}
 		}
 
+		SampleType x = (SampleType)xn;
+
 		// --- for 1st order filters:
 		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
 			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
 			filterAlgorithm == vaFilterAlgorithm::kAPF1)
 		{
 			// --- create vn node
-			double vn = (xn - integrator_z[0]) * alpha;
+			SampleType vn = (x - integrator_z[0]) * alpha;
 
 			// --- form LP output
-			double lpf = ((xn - integrator_z[0]) * alpha) + integrator_z[0];
+			SampleType lpf = ((x - integrator_z[0]) * alpha) + integrator_z[0];
 
 			// double sn = integrator_z[0];
 
@@ -110,10 +133,10 @@ public:
 			integrator_z[0] = vn + lpf;
 
 			// --- form the HPF = INPUT = LPF
-			double hpf = xn - lpf;
+			SampleType hpf = x - lpf;
 
 			// --- form the APF = LPF - HPF
-			double apf = lpf - hpf;
+			SampleType apf = lpf - hpf;
 
 			// --- set the outputs
 			if (filterAlgorithm == vaFilterAlgorithm::kLPF1)
@@ -130,35 +153,35 @@ public:
 				return apf;
 
 			// --- unknown filter
-			return xn;
+			return x;
 		}
 
 		// --- form the HP output first
-		double hpf = alpha0 * (xn - rho * integrator_z[0] - integrator_z[1]);
+		SampleType hpf = alpha0 * (x - rho * integrator_z[0] - integrator_z[1]);
 
 		// --- BPF Out
-		double bpf = alpha * hpf + integrator_z[0];
+		SampleType bpf = alpha * hpf + integrator_z[0];
 		if (zvaFilterParameters.enableNLP)
 		{
 			//bpf = softClipWaveShaper(bpf, 1.0);
 			// homework, replacing line above, if you want softClipWaveShaper(), comment this and uncomment line above
-			bpf = mPeakLimiter.processAudioSample(bpf);
+			bpf = (SampleType)mPeakLimiter.processAudioSample(bpf);
 		}
 
 		// --- LPF Out
-		double lpf = alpha * bpf + integrator_z[1];
+		SampleType lpf = alpha * bpf + integrator_z[1];
 
 		// --- BSF Out
-		double bsf = hpf + lpf;
+		SampleType bsf = hpf + lpf;
 
 		// --- finite gain at Nyquist; slight error at VHF
-		double sn = integrator_z[0];
+		SampleType sn = integrator_z[0];
 
 		// update memory
 		integrator_z[0] = alpha * hpf + bpf;
 		integrator_z[1] = alpha * bpf + lpf;
 
-		double filterOutputGain = pow(10.0, zvaFilterParameters.filterOutputGain_dB / 20.0);
+		SampleType filterOutputGain = (SampleType)fastPow10(zvaFilterParameters.filterOutputGain_dB / 20.0, designAccuracy);
 
 		// return our selected type
 		if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP)
@@ -178,9 +201,18 @@ public:
 		return filterOutputGain * lpf;
 	}
 
+	/** process a block through the VA filter; gain compensation, output gain and the
+		filter type are decoded once per block instead of once per sample */
+	virtual void processBlock(const float* in, float* out, uint32_t n) { processBlockT(in, out, n); }
+
+	/** process a block through the VA filter, double precision version */
+	virtual void processBlock(const double* in, double* out, uint32_t n) { processBlockT(in, out, n); }
+
 	/** recalculate the filter coefficients*/
 	void calculateFilterCoeffs()
 	{
+		coeffsDirty = false;
+
 		double fc = zvaFilterParameters.fc;
 		double Q = zvaFilterParameters.Q;
 		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
@@ -189,7 +221,7 @@ public:
 		//     prewarp the cutoff- these are bilinear-transform filters
 		// simplified g calculation
 		double T = 1.0 / sampleRate;
-		double g = tan(fc * kPi * T / 2.0); // fix for wrong frequency response, division by 2 to remove doubling of fc
+		double g = fastTan(fc * kPi * T / 2.0, designAccuracy); // fix for wrong frequency response, division by 2 to remove doubling of fc
 
 		// --- for 1st order filters:
 		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
@@ -213,6 +245,112 @@ public:
 		}
 	}
 
+	/** set the math tier for the tan( ) prewarp and the output gain, see FastMath.h */
+	/**
+	\param _accuracy kExact (libm), kHigh (about 1e-7) or kLow (about 1e-4 relative error)
+	*/
+	void setMathAccuracy(mathAccuracy _accuracy)
+	{
+		designAccuracy = _accuracy;
+		coeffsDirty = true;
+	}
+
+	/** get the math tier */
+	mathAccuracy getMathAccuracy() { return designAccuracy; }
+
+	/** the { a0, a1, a2, b1, b2, c0, d0 } array with the same linear response as the current settings: the
+		one-pole and SVF structures are trapezoidal integrator filters, i.e. bilinear transforms of 1/(s + 1) and
+		1/(s^2 + 2Rs + 1) with s prewarped by g, so their outputs are exactly a biquad. The NLP limiter is left out. */
+	/**
+	\param coeffArray receives numCoeffs coefficients
+	*/
+	void getBiquadCoefficients(double* coeffArray)
+	{
+		updateCoefficients();
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
+
+		// --- gain compensation; same logic as processAudioSample( )
+		double gain = 1.0;
+		if (zvaFilterParameters.enableGainComp)
+		{
+			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
+			if (peak_dB > 0.0)
+				gain = dB2Raw(-peak_dB / 2.0);
+		}
+
+		// --- the prototypes are written in s' = g*s so that K = 1 and g = 0 needs no special case
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			// --- alpha = g/(1 + g); y = lpfGain*lpf + hpfGain*hpf as in processBlockT( )
+			double g = (double)alpha / (1.0 - (double)alpha);
+			double lpfGain = 1.0;
+			double hpfGain = 0.0;
+			if (filterAlgorithm == vaFilterAlgorithm::kLPF1 && matchAnalogNyquistLPF)
+				hpfGain = alpha;
+			else if (filterAlgorithm == vaFilterAlgorithm::kHPF1)
+			{
+				lpfGain = 0.0;
+				hpfGain = 1.0;
+			}
+			else if (filterAlgorithm == vaFilterAlgorithm::kAPF1)
+				hpfGain = -1.0;
+
+			// --- LPF = g/(s' + g), HPF = s'/(s' + g)
+			bilinearTransformCoeffs(lpfGain * g, hpfGain, 0.0, g, 1.0, 0.0, 1.0, coeffArray);
+		}
+		else
+		{
+			// --- alpha = g, rho = 2R + g; y = gain*(lpfGain*lpf + hpfGain*hpf + bpfGain*bpf + snGain*sn)
+			double g = alpha;
+			double twoR = (double)rho - g;
+			double lpfGain = 0.0;
+			double hpfGain = 0.0;
+			double bpfGain = 0.0;
+			double snGain = 0.0;
+			if (filterAlgorithm == vaFilterAlgorithm::kSVF_HP)
+				hpfGain = 1.0;
+			else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BP)
+				bpfGain = 1.0;
+			else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BS)
+			{
+				lpfGain = 1.0;
+				hpfGain = 1.0;
+			}
+			else
+			{
+				lpfGain = 1.0;
+				if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP && matchAnalogNyquistLPF)
+					snGain = analogMatchSigma;
+			}
+			gain *= (SampleType)fastPow10(zvaFilterParameters.filterOutputGain_dB / 20.0, designAccuracy);
+
+			// --- HPF = s'^2, BPF = g*s', LPF = g^2 over s'^2 + 2R*g*s' + g^2; sn = z0 = bpf - g*hpf
+			bilinearTransformCoeffs(lpfGain * g * g, (bpfGain + snGain) * g, hpfGain - snGain * g,
+				g * g, twoR * g, 1.0, 1.0, coeffArray);
+		}
+
+		coeffArray[a0] *= gain;
+		coeffArray[a1] *= gain;
+		coeffArray[a2] *= gain;
+	}
+
+	/** magnitude and phase of the current settings from getBiquadCoefficients( ), see FrequencyResponse.h */
+	/**
+	\param frequencies count frequencies in Hz
+	\param count number of frequencies
+	\param magnitude_dB receives count magnitudes in dB
+	\param phase receives count phases in radians; may be nullptr
+	*/
+	void getFrequencyResponse(const double* frequencies, uint32_t count, double* magnitude_dB, double* phase = nullptr)
+	{
+		double coeffArray[numCoeffs] = { 0.0 };
+		getBiquadCoefficients(coeffArray);
+		getBiquadFrequencyResponse(coeffArray, sampleRate, frequencies, count, magnitude_dB, phase);
+	}
+
 	/** set beta value, for filters that aggregate 1st order VA sections*/
 	void setBeta(double _beta) { beta = _beta; }
 
@@ -220,24 +358,127 @@ public:
 	double getBeta() { return beta; }
 
 protected:
+	/** block worker, shared by the float and double overrides */
+	template <typename BufferType>
+	void processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+	{
+		// --- parameter changes since the last block
+		updateCoefficients();
+
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
+
+		// --- gain compensation; same logic as processAudioSample( )
+		SampleType inputGain = 1.0;
+		if (zvaFilterParameters.enableGainComp)
+		{
+			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
+			if (peak_dB > 0.0)
+				inputGain = (SampleType)dB2Raw(-peak_dB / 2.0);
+		}
+
+		SampleType z0 = integrator_z[0];
+		SampleType z1 = integrator_z[1];
+
+		// --- for 1st order filters:
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			// --- decode the output as y = lpfGain*lpf + hpfGain*hpf
+			SampleType lpfGain = 1.0;
+			SampleType hpfGain = 0.0;
+			if (filterAlgorithm == vaFilterAlgorithm::kLPF1 && matchAnalogNyquistLPF)
+				hpfGain = alpha;
+			else if (filterAlgorithm == vaFilterAlgorithm::kHPF1)
+			{
+				lpfGain = 0.0;
+				hpfGain = 1.0;
+			}
+			else if (filterAlgorithm == vaFilterAlgorithm::kAPF1)
+				hpfGain = -1.0;
+
+			for (uint32_t i = 0; i < n; i++)
+			{
+				SampleType xn = (SampleType)in[i] * inputGain;
+				SampleType vn = (xn - z0) * alpha;
+				SampleType lpf = vn + z0;
+				z0 = vn + lpf;
+				SampleType hpf = xn - lpf;
+				out[i] = (BufferType)(lpfGain * lpf + hpfGain * hpf);
+			}
+
+			integrator_z[0] = z0;
+			return;
+		}
+
+		// --- decode the output as y = gain*(lpfGain*lpf + hpfGain*hpf + bpfGain*bpf + snGain*sn)
+		SampleType lpfGain = 0.0;
+		SampleType hpfGain = 0.0;
+		SampleType bpfGain = 0.0;
+		SampleType snGain = 0.0;
+		if (filterAlgorithm == vaFilterAlgorithm::kSVF_HP)
+			hpfGain = 1.0;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BP)
+			bpfGain = 1.0;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BS)
+		{
+			lpfGain = 1.0;
+			hpfGain = 1.0;
+		}
+		else
+		{
+			// --- kSVF_LP and unknown filters
+			lpfGain = 1.0;
+			if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP && matchAnalogNyquistLPF)
+				snGain = analogMatchSigma;
+		}
+
+		const SampleType filterOutputGain = (SampleType)fastPow10(zvaFilterParameters.filterOutputGain_dB / 20.0, designAccuracy);
+		const bool enableNLP = zvaFilterParameters.enableNLP;
+
+		for (uint32_t i = 0; i < n; i++)
+		{
+			SampleType xn = (SampleType)in[i] * inputGain;
+			SampleType hpf = alpha0 * (xn - rho * z0 - z1);
+			SampleType bpf = alpha * hpf + z0;
+			if (enableNLP)
+				bpf = (SampleType)mPeakLimiter.processAudioSample(bpf);
+			SampleType lpf = alpha * bpf + z1;
+			SampleType sn = z0;
+
+			z0 = alpha * hpf + bpf;
+			z1 = alpha * bpf + lpf;
+
+			out[i] = (BufferType)(filterOutputGain * (lpfGain * lpf + hpfGain * hpf + bpfGain * bpf + snGain * sn));
+		}
+
+		integrator_z[0] = z0;
+		integrator_z[1] = z1;
+	}
+
 	ZVAFilterParameters zvaFilterParameters;	///< object parameters
 	double sampleRate = 44100.0;				///< current sample rate
 
 	// --- state storage
-	double integrator_z[2] = { 0.0, 0.0 };						///< state variables
+	SampleType integrator_z[2] = { 0.0, 0.0 };						///< state variables
 
 	// --- filter coefficients
-	double alpha0 = 0.0;		///< input scalar, correct delay-free loop
-	double alpha = 0.0;			///< alpha is (wcT/2)
-	double rho = 0.0;			///< p = 2R + g (feedback)
+	SampleType alpha0 = 0.0;		///< input scalar, correct delay-free loop
+	SampleType alpha = 0.0;			///< alpha is (wcT/2)
+	SampleType rho = 0.0;			///< p = 2R + g (feedback)
 
 	double beta = 0.0;			///< beta value, not used
+	mathAccuracy designAccuracy = mathAccuracy::kExact;	///< math tier for the coefficient design
+	bool coeffsDirty = true;	///< coefficients are out of date; recalculated by the next updateCoefficients( )
 
 	// --- for analog Nyquist matching
-	double analogMatchSigma = 0.0; ///< analog matching Sigma value (see book)
+	SampleType analogMatchSigma = 0.0; ///< analog matching Sigma value (see book)
 
 	// Homework chapter 12 - 5
 	// replace softClipWaveShaper() with PeakLimiter
 	PeakLimiter mPeakLimiter;
 
-};
\ No newline at end of file
+};
+
+using ZVAFilter = BasicZVAFilter<double>;
\ No newline at end of file
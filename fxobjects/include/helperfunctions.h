@@ -3,6 +3,16 @@
 #include "Constants.h"
 #include <math.h>
 
+/** marks a rarely taken member function (e.g. a once per control interval update) so the compiler keeps it out
+	of the per-sample loop that calls it */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define FXOBJECTS_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define FXOBJECTS_NOINLINE __attribute__((noinline))
+#else
+#define FXOBJECTS_NOINLINE
+#endif
+
 namespace fxobjects
 	{
 		/**
@@ -30,6 +40,27 @@ namespace fxobjects
 		return retValue;
 	}
 
+	/**
+	@checkKernelUnderflow
+	\ingroup FX-Functions
+
+	@brief underflow check used inside the hot recursive kernels (biquads, envelope detector), for float
+	or double state; defining FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE compiles it out, which is only safe
+	when every block is processed under a ScopedDenormalGuard (see DenormalGuard.h) so the FPU flushes instead
+
+	\param value - the value to check for underflow
+	*/
+	template <typename T>
+	inline void checkKernelUnderflow([[maybe_unused]] T& value)
+	{
+#ifndef FXOBJECTS_FLUSH_DENORMALS_IN_HARDWARE
+		if (value > (T)0.0 && value < (T)kSmallestPositiveFloatValue)
+			value = (T)0.0;
+		else if (value < (T)0.0 && value > (T)kSmallestNegativeFloatValue)
+			value = (T)0.0;
+#endif
+	}
+
 	/**
 	@doLinearInterpolation
 	\ingroup FX-Functions
@@ -0,0 +1,584 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "include/AudioFilter.h"
+#include "include/Constants.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	// --- filters per pass through the array math; keeps the SoA scratch at a few KB of stack
+	const uint32_t kBatchChunk = 64;
+
+	// --- adding 1.5*2^52 rounds a double below 2^51 to an integer, and leaves that integer in the low mantissa bits
+	using fastmath::kRoundMagic;
+	const uint64_t kRoundMagicBits = 0x4338000000000000ULL;
+
+	inline uint64_t toBits(double x)
+	{
+		uint64_t bits = 0;
+		memcpy(&bits, &x, sizeof(double));
+		return bits;
+	}
+
+	inline double fromBits(uint64_t bits)
+	{
+		double x = 0.0;
+		memcpy(&x, &bits, sizeof(double));
+		return x;
+	}
+
+	// --- bitwise select, mask is all ones or all zeros; keeps the array loops free of branches
+	inline double selectBits(uint64_t mask, double ifSet, double ifClear)
+	{
+		return fromBits((toBits(ifSet) & mask) | (toBits(ifClear) & ~mask));
+	}
+
+	// --- true if every argument is inside the fast reduction range (false for NaN)
+	inline bool allWithin(const double* x, uint32_t n, double low, double high)
+	{
+		uint32_t outside = 0;
+		for (uint32_t i = 0; i < n; i++)
+			outside += !(x[i] > low && x[i] < high);
+		return outside == 0;
+	}
+
+	// --- array versions of the FastMath.h functions for the fast tiers: same reductions and kernels, with
+	//     the quadrant logic done on bit patterns so that the loops vectorize. A chunk with an argument
+	//     outside the reduction range goes through the scalar functions.
+	template <mathAccuracy accuracy>
+	void tanArray(const double* x, double* y, uint32_t n)
+	{
+		if (!allWithin(x, n, -fastmath::kMaxTrigArgument, fastmath::kMaxTrigArgument))
+		{
+			for (uint32_t i = 0; i < n; i++)
+				y[i] = fastTan<accuracy>(x[i]);
+			return;
+		}
+
+		for (uint32_t i = 0; i < n; i++)
+		{
+			double kMagic = x[i] * fastmath::kTwoOverPi + kRoundMagic;
+			double k = kMagic - kRoundMagic;
+			double r = (x[i] - k * 1.5707963267341256141662597656250) - k * 6.07710050650619224932e-11;
+			double t = fastmath::tanKernel<accuracy>(r);
+
+			// --- odd quadrants: tan(r + pi/2) = -1/tan(r)
+			uint64_t oddMask = 0 - (toBits(kMagic) & 1);
+			y[i] = selectBits(oddMask, -1.0 / t, t);
+		}
+	}
+
+	template <mathAccuracy accuracy>
+	void sinCosArray(const double* x, double* s, double* c, uint32_t n)
+	{
+		if (!allWithin(x, n, -fastmath::kMaxTrigArgument, fastmath::kMaxTrigArgument))
+		{
+			for (uint32_t i = 0; i < n; i++)
+			{
+				s[i] = fastSin<accuracy>(x[i]);
+				c[i] = fastCos<accuracy>(x[i]);
+			}
+			return;
+		}
+
+		for (uint32_t i = 0; i < n; i++)
+		{
+			double kMagic = x[i] * fastmath::kTwoOverPi + kRoundMagic;
+			double k = kMagic - kRoundMagic;
+			double r = (x[i] - k * 1.5707963267341256141662597656250) - k * 6.07710050650619224932e-11;
+			double sinR = fastmath::sinKernel<accuracy>(r);
+			double cosR = fastmath::cosKernel<accuracy>(r);
+
+			// --- quadrant q: odd swaps sin/cos, sin is negated in q = 2, 3 and cos in q = 1, 2
+			uint64_t quadrant = toBits(kMagic) & 3;
+			uint64_t swapMask = 0 - (quadrant & 1);
+			s[i] = fromBits(toBits(selectBits(swapMask, cosR, sinR)) ^ ((quadrant & 2) << 62));
+			c[i] = fromBits(toBits(selectBits(swapMask, sinR, cosR)) ^ (((quadrant + 1) & 2) << 62));
+		}
+	}
+
+	template <mathAccuracy accuracy>
+	void pow10Array(const double* x, double* y, uint32_t n)
+	{
+		// --- 10^x = e^(x ln10); the exp argument must stay in the normal 2^n range
+		const double limit = fastmath::kMaxExpArgument / fastmath::kLn10;
+		if (!allWithin(x, n, -limit, limit))
+		{
+			for (uint32_t i = 0; i < n; i++)
+				y[i] = fastPow10<accuracy>(x[i]);
+			return;
+		}
+
+		for (uint32_t i = 0; i < n; i++)
+		{
+			double t = x[i] * (fastmath::kLn10 * fastmath::kLog2e);
+			double nMagic = t + kRoundMagic;
+			double r = (t - (nMagic - kRoundMagic)) * fastmath::kLn2;
+
+			// --- 2^n straight into the exponent field
+			y[i] = fastmath::expKernel<accuracy>(r) * fromBits((toBits(nMagic) - kRoundMagicBits + 1023) << 52);
+		}
+	}
+
+	// --- one chunk of an algorithm group, gathered into structure-of-arrays form
+	struct BatchChunk
+	{
+		uint32_t n = 0;
+		double fc[kBatchChunk];
+		double Q[kBatchChunk];
+		double boostCut_dB[kBatchChunk];
+		double sampleRate[kBatchChunk];
+		double coeffs[numCoeffs][kBatchChunk];
+
+		// --- array math operands
+		double arg[kBatchChunk];
+		double arg2[kBatchChunk];
+		double sinValue[kBatchChunk];
+		double cosValue[kBatchChunk];
+		double tanValue[kBatchChunk];
+		double mu[kBatchChunk];
+	};
+
+	// --- the algorithms with a structure-of-arrays design below; everything else uses the scalar equations. The
+	//     others either have no closed form worth splitting into stages (MMA, matched, impulse invariant) or
+	//     a scalar design so cheap that the gather/scatter eats the array gain (AudioFilterBatchBenchmark)
+	constexpr bool hasArrayDesign(filterAlgorithm algorithm)
+	{
+		switch (algorithm)
+		{
+		case filterAlgorithm::kLPF1: case filterAlgorithm::kHPF1: case filterAlgorithm::kLPF2: case filterAlgorithm::kHPF2:
+		case filterAlgorithm::kBPF2Boost: case filterAlgorithm::kButterLPF2: case filterAlgorithm::kButterHPF2:
+		case filterAlgorithm::kLowShelf: case filterAlgorithm::kHiShelf: case filterAlgorithm::kNCQParaEQ:
+		case filterAlgorithm::kLWRLPF2: case filterAlgorithm::kLWRHPF2:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// --- the designAudioFilter( ) equations (AudioFilterDesign.h), written term for term so that only the array
+	//     math separates them from the scalar results, one loop per stage across the chunk
+	template <mathAccuracy accuracy>
+	void designChunk(filterAlgorithm algorithm, BatchChunk& ch)
+	{
+		const uint32_t n = ch.n;
+		double* A0 = ch.coeffs[a0];
+		double* A1 = ch.coeffs[a1];
+		double* A2 = ch.coeffs[a2];
+		double* B1 = ch.coeffs[b1];
+		double* B2 = ch.coeffs[b2];
+		double* C0 = ch.coeffs[c0];
+		double* D0 = ch.coeffs[d0];
+
+		// --- pass-through mix, as the scalar design
+		for (uint32_t i = 0; i < n; i++)
+		{
+			C0[i] = 1.0;
+			D0[i] = 0.0;
+		}
+
+		switch (algorithm)
+		{
+		case filterAlgorithm::kLPF1:
+		case filterAlgorithm::kHPF1:
+		{
+			for (uint32_t i = 0; i < n; i++)
+				ch.arg[i] = 2.0 * kPi * ch.fc[i] / ch.sampleRate[i];
+			sinCosArray<accuracy>(ch.arg, ch.sinValue, ch.cosValue, n);
+
+			const bool lowpass = algorithm == filterAlgorithm::kLPF1;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double gamma = ch.cosValue[i] / (1.0 + ch.sinValue[i]);
+				A0[i] = lowpass ? (1.0 - gamma) / 2.0 : (1.0 + gamma) / 2.0;
+				A1[i] = lowpass ? (1.0 - gamma) / 2.0 : -(1.0 + gamma) / 2.0;
+				A2[i] = 0.0;
+				B1[i] = -gamma;
+				B2[i] = 0.0;
+			}
+			break;
+		}
+		case filterAlgorithm::kLPF2:
+		case filterAlgorithm::kHPF2:
+		{
+			for (uint32_t i = 0; i < n; i++)
+				ch.arg[i] = 2.0 * kPi * ch.fc[i] / ch.sampleRate[i];
+			sinCosArray<accuracy>(ch.arg, ch.sinValue, ch.cosValue, n);
+
+			const bool lowpass = algorithm == filterAlgorithm::kLPF2;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double d = 1.0 / ch.Q[i];
+				double betaNumerator = 1.0 - ((d / 2.0) * (ch.sinValue[i]));
+				double betaDenominator = 1.0 + ((d / 2.0) * (ch.sinValue[i]));
+
+				double beta = 0.5 * (betaNumerator / betaDenominator);
+				double gamma = (0.5 + beta) * (ch.cosValue[i]);
+				double alpha = lowpass ? (0.5 + beta - gamma) / 2.0 : (0.5 + beta + gamma) / 2.0;
+
+				A0[i] = alpha;
+				A1[i] = lowpass ? 2.0 * alpha : -2.0 * alpha;
+				A2[i] = alpha;
+				B1[i] = -2.0 * gamma;
+				B2[i] = 2.0 * beta;
+			}
+			break;
+		}
+		case filterAlgorithm::kBPF2Boost:
+		{
+			for (uint32_t i = 0; i < n; i++)
+			{
+				ch.arg[i] = kPi * ch.fc[i] / ch.sampleRate[i];
+				ch.arg2[i] = ch.boostCut_dB[i] / 20.0;
+			}
+			tanArray<accuracy>(ch.arg, ch.tanValue, n);
+			pow10Array<accuracy>(ch.arg2, ch.mu, n);
+
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double K = ch.tanValue[i];
+				double Q = ch.Q[i];
+				double delta = K * K * Q + K + Q;
+
+				A0[i] = (K / delta) * ch.mu[i];
+				A1[i] = 0.0;
+				A2[i] = (-K / delta) * ch.mu[i];
+				B1[i] = 2.0 * Q * (K * K - 1) / delta;
+				B2[i] = (K * K * Q - K + Q) / delta;
+			}
+			break;
+		}
+		case filterAlgorithm::kButterLPF2:
+		case filterAlgorithm::kButterHPF2:
+		{
+			for (uint32_t i = 0; i < n; i++)
+				ch.arg[i] = kPi * ch.fc[i] / ch.sampleRate[i];
+			tanArray<accuracy>(ch.arg, ch.tanValue, n);
+
+			const bool lowpass = algorithm == filterAlgorithm::kButterLPF2;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double C = lowpass ? 1.0 / ch.tanValue[i] : ch.tanValue[i];
+				double alpha = 1.0 / (1.0 + kSqrtTwo * C + C * C);
+
+				A0[i] = alpha;
+				A1[i] = lowpass ? 2.0 * alpha : -2.0 * alpha;
+				A2[i] = alpha;
+				B1[i] = lowpass ? 2.0 * alpha * (1.0 - C * C) : 2.0 * alpha * (C * C - 1.0);
+				B2[i] = alpha * (1.0 - kSqrtTwo * C + C * C);
+			}
+			break;
+		}
+		case filterAlgorithm::kLowShelf:
+		case filterAlgorithm::kHiShelf:
+		{
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double theta_c = 2.0 * kPi * ch.fc[i] / ch.sampleRate[i];
+				ch.arg[i] = theta_c / 2.0;
+				ch.arg2[i] = ch.boostCut_dB[i] / 20.0;
+			}
+			tanArray<accuracy>(ch.arg, ch.tanValue, n);
+			pow10Array<accuracy>(ch.arg2, ch.mu, n);
+
+			const bool lowShelf = algorithm == filterAlgorithm::kLowShelf;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double mu = ch.mu[i];
+				double beta = lowShelf ? 4.0 / (1.0 + mu) : (1.0 + mu) / 4.0;
+				double delta = beta * ch.tanValue[i];
+				double gamma = (1.0 - delta) / (1.0 + delta);
+
+				A0[i] = lowShelf ? (1.0 - gamma) / 2.0 : (1.0 + gamma) / 2.0;
+				A1[i] = lowShelf ? (1.0 - gamma) / 2.0 : -((1.0 + gamma) / 2.0);
+				A2[i] = 0.0;
+				B1[i] = -gamma;
+				B2[i] = 0.0;
+				C0[i] = mu - 1.0;
+				D0[i] = 1.0;
+			}
+			break;
+		}
+		case filterAlgorithm::kNCQParaEQ:
+		{
+			for (uint32_t i = 0; i < n; i++)
+			{
+				ch.arg[i] = 2.0 * kPi * ch.fc[i] / ch.sampleRate[i];
+				double tanArg = ch.arg[i] / (2.0 * ch.Q[i]);
+				ch.arg2[i] = tanArg >= 0.95 * kPi / 2.0 ? 0.95 * kPi / 2.0 : tanArg;
+			}
+			tanArray<accuracy>(ch.arg2, ch.tanValue, n);
+			sinCosArray<accuracy>(ch.arg, ch.sinValue, ch.cosValue, n);
+
+			for (uint32_t i = 0; i < n; i++)
+				ch.arg2[i] = ch.boostCut_dB[i] / 20.0;
+			pow10Array<accuracy>(ch.arg2, ch.mu, n);
+
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double mu = ch.mu[i];
+				double zeta = 4.0 / (1.0 + mu);
+				double betaNumerator = 1.0 - zeta * ch.tanValue[i];
+				double betaDenominator = 1.0 + zeta * ch.tanValue[i];
+
+				double beta = 0.5 * (betaNumerator / betaDenominator);
+				double gamma = (0.5 + beta) * (ch.cosValue[i]);
+				double alpha = (0.5 - beta);
+
+				A0[i] = alpha;
+				A1[i] = 0.0;
+				A2[i] = -alpha;
+				B1[i] = -2.0 * gamma;
+				B2[i] = 2.0 * beta;
+				C0[i] = mu - 1.0;
+				D0[i] = 1.0;
+			}
+			break;
+		}
+		case filterAlgorithm::kLWRLPF2:
+		case filterAlgorithm::kLWRHPF2:
+		{
+			for (uint32_t i = 0; i < n; i++)
+				ch.arg[i] = kPi * ch.fc[i] / ch.sampleRate[i];
+			tanArray<accuracy>(ch.arg, ch.tanValue, n);
+
+			const bool lowpass = algorithm == filterAlgorithm::kLWRLPF2;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				double omega_c = kPi * ch.fc[i];
+				double k = omega_c / ch.tanValue[i];
+				double denominator = k * k + omega_c * omega_c + 2.0 * k * omega_c;
+				double b1_Num = -2.0 * k * k + 2.0 * omega_c * omega_c;
+				double b2_Num = -2.0 * k * omega_c + k * k + omega_c * omega_c;
+
+				A0[i] = lowpass ? omega_c * omega_c / denominator : k * k / denominator;
+				A1[i] = lowpass ? 2.0 * omega_c * omega_c / denominator : -2.0 * k * k / denominator;
+				A2[i] = A0[i];
+				B1[i] = b1_Num / denominator;
+				B2[i] = b2_Num / denominator;
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	const uint32_t kNumAlgorithms = (uint32_t)filterAlgorithm::kImpInvLP2 + 1;
+	const uint32_t kNumGroups = 3 * kNumAlgorithms;
+
+	// --- the list is scanned in aligned blocks of this many entries; a run of one array group that covers two
+	//     whole blocks goes through the array math, which pays from about that length on (AudioFilterBatchBenchmark)
+	const uint32_t kRunBlock = 8;
+
+	// --- true for the groups with an array design: kHigh and kLow, array algorithms; index kNumGroups stands
+	//     for the entries the batch skips
+	struct ArrayGroups
+	{
+		bool array[kNumGroups + 1] = {};
+
+		constexpr ArrayGroups()
+		{
+			for (uint32_t g = kNumAlgorithms; g < kNumGroups; g++)
+				array[g] = hasArrayDesign((filterAlgorithm)(g % kNumAlgorithms));
+		}
+	};
+	constexpr ArrayGroups kArrayGroups;
+
+	// --- design one run of one array group through the array math
+	template <mathAccuracy accuracy, typename Access>
+	void designArrayRun(filterAlgorithm algorithm, Access& access, uint32_t first, uint32_t count)
+	{
+		BatchChunk chunk;
+		for (uint32_t start = 0; start < count; start += kBatchChunk)
+		{
+			chunk.n = std::min(kBatchChunk, count - start);
+
+			// --- gather
+			for (uint32_t i = 0; i < chunk.n; i++)
+			{
+				const AudioFilterParameters& parameters = access.parameters(first + start + i);
+				chunk.fc[i] = parameters.fc;
+				chunk.Q[i] = parameters.Q;
+				chunk.boostCut_dB[i] = parameters.boostCut_dB;
+				chunk.sampleRate[i] = access.sampleRate(first + start + i);
+			}
+
+			designChunk<accuracy>(algorithm, chunk);
+
+			// --- scatter
+			for (uint32_t i = 0; i < chunk.n; i++)
+			{
+				double* coeffArray = access.coeffArray(first + start + i);
+				for (uint32_t j = 0; j < numCoeffs; j++)
+					coeffArray[j] = chunk.coeffs[j][i];
+				access.designed(first + start + i, true);
+			}
+		}
+	}
+
+	// --- true if the entries first to last all belong to group
+	template <typename Access>
+	inline bool uniformGroup(Access& access, uint32_t group, uint32_t first, uint32_t last)
+	{
+		uint32_t mixed = 0;
+		for (uint32_t i = first; i < last; i++)
+			mixed |= access.group(i) ^ group;
+		return mixed == 0;
+	}
+
+	// --- design the list in place: runs of one array group covering two aligned blocks go through the array
+	//     math, everything in between through the plain loop. The list is neither copied nor reordered, so the
+	//     batch doesn't allocate; where it can't pay, it costs the plain loop three group reads per block.
+	template <typename Access>
+	void designBatch(Access& access, uint32_t count)
+	{
+		uint32_t designedTo = 0;
+		for (uint32_t pairStart = 0; pairStart + 2 * kRunBlock <= count; pairStart += kRunBlock)
+		{
+			// --- the ends of the two blocks first, without branches, then every entry
+			const uint32_t pairEnd = pairStart + 2 * kRunBlock;
+			const uint32_t g = std::min(access.group(pairStart), kNumGroups);
+			const bool candidate = kArrayGroups.array[g] & (access.group(pairStart + kRunBlock) == g) &
+				(access.group(pairEnd - 1) == g);
+			if (!candidate || !uniformGroup(access, g, pairStart, pairEnd))
+				continue;
+
+			// --- extend the run past the two blocks to its first and last entry
+			uint32_t runStart = pairStart;
+			uint32_t runEnd = pairEnd;
+			while (runStart > designedTo && access.group(runStart - 1) == g)
+				runStart--;
+			while (runEnd < count && access.group(runEnd) == g)
+				runEnd++;
+
+			access.designScalar(designedTo, runStart);
+			if (g < 2 * kNumAlgorithms)
+				designArrayRun<mathAccuracy::kHigh>((filterAlgorithm)(g % kNumAlgorithms), access, runStart, runEnd - runStart);
+			else
+				designArrayRun<mathAccuracy::kLow>((filterAlgorithm)(g % kNumAlgorithms), access, runStart, runEnd - runStart);
+			designedTo = runEnd;
+
+			// --- carry on from the first whole block after the run
+			pairStart = (runEnd + kRunBlock - 1) / kRunBlock * kRunBlock - kRunBlock;
+		}
+
+		access.designScalar(designedTo, count);
+	}
+
+	// --- group index for a tier and algorithm; out of range algorithms share the tier's last group, which has
+	//     no array design, and are rejected by the scalar design
+	inline uint32_t batchGroup(mathAccuracy accuracy, filterAlgorithm algorithm)
+	{
+		uint32_t alg = std::min((uint32_t)algorithm, kNumAlgorithms - 1);
+		return (uint32_t)accuracy * kNumAlgorithms + alg;
+	}
+
+	// --- calculateFilterCoeffsBatch( ) list: parameter and coefficient arrays
+	struct ArrayAccess
+	{
+		const AudioFilterParameters* parameterArray;
+		double* coeffArrays;
+		double fs;
+		mathAccuracy accuracy;
+
+		uint32_t group(uint32_t i) { return batchGroup(accuracy, parameterArray[i].algorithm); }
+		const AudioFilterParameters& parameters(uint32_t i) { return parameterArray[i]; }
+		double sampleRate([[maybe_unused]] uint32_t i) { return fs; }
+		double* coeffArray(uint32_t i) { return &coeffArrays[i * numCoeffs]; }
+		void designed([[maybe_unused]] uint32_t i, [[maybe_unused]] bool decoded) {}
+
+		// --- the plain loop over entries first to last; locals, so that the calls can't force reloads
+		void designScalar(uint32_t first, uint32_t last)
+		{
+			const AudioFilterParameters* parameters = parameterArray;
+			double* coeffs = coeffArrays;
+			const double sampleRate = fs;
+			const mathAccuracy tier = accuracy;
+			for (uint32_t i = first; i < last; i++)
+				AudioFilter::calculateFilterCoeffs(parameters[i], sampleRate, &coeffs[i * numCoeffs], tier);
+		}
+	};
+}
+
+template <typename SampleType>
+void BasicAudioFilter<SampleType>::calculateFilterCoeffsBatch(const AudioFilterParameters* parameters, uint32_t count,
+	double sampleRate, double* coeffArrays, mathAccuracy accuracy)
+{
+	// --- libm doesn't vectorize, so kExact has nothing to gain from the arrays: the plain loop
+	if (accuracy == mathAccuracy::kExact)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			calculateFilterCoeffs(parameters[i], sampleRate, &coeffArrays[i * numCoeffs], accuracy);
+		return;
+	}
+
+	ArrayAccess access = { parameters, coeffArrays, sampleRate, accuracy };
+	designBatch(access, count);
+}
+
+template <typename SampleType>
+struct BasicAudioFilter<SampleType>::FilterListAccess
+{
+	BasicAudioFilter<SampleType>* const* filters;
+
+	uint32_t group(uint32_t i)
+	{
+		// --- filters on coefficient tables were updated one at a time; no group, so the batch skips them
+		if (filters[i]->useCoeffTable)
+			return ~0u;
+		return batchGroup(filters[i]->designAccuracy, filters[i]->audioFilterParameters.algorithm);
+	}
+	const AudioFilterParameters& parameters(uint32_t i) { return filters[i]->audioFilterParameters; }
+	double sampleRate(uint32_t i) { return filters[i]->sampleRate; }
+	double* coeffArray(uint32_t i) { return filters[i]->coeffArray; }
+
+	// --- load the biquad; undecoded algorithms leave it alone, as calculateFilterCoeffs( )
+	void designed(uint32_t i, bool decoded)
+	{
+		if (decoded)
+			filters[i]->biquad.setCoefficients(filters[i]->coeffArray);
+	}
+
+	// --- the plain loop over entries first to last, each filter at its own tier
+	void designScalar(uint32_t first, uint32_t last)
+	{
+		BasicAudioFilter<SampleType>* const* list = filters;
+		for (uint32_t i = first; i < last; i++)
+		{
+			BasicAudioFilter<SampleType>* filter = list[i];
+			if (!filter->useCoeffTable && calculateFilterCoeffs(filter->audioFilterParameters, filter->sampleRate,
+				filter->coeffArray, filter->designAccuracy))
+				filter->biquad.setCoefficients(filter->coeffArray);
+		}
+	}
+};
+
+template <typename SampleType>
+void BasicAudioFilter<SampleType>::updateFilters(BasicAudioFilter<SampleType>* const* filters, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		// --- don't allow 0 or (-) values for Q
+		if (filters[i]->audioFilterParameters.Q <= 0)
+			filters[i]->audioFilterParameters.Q = 0.707;
+
+		// --- the batch replaces any pending design
+		filters[i]->coeffsDirty = false;
+		filters[i]->pendingRampLength = 0;
+
+		if (filters[i]->useCoeffTable)
+			filters[i]->calculateFilterCoeffs();
+	}
+
+	FilterListAccess access = { filters };
+	designBatch(access, count);
+}
+
+// --- the two precisions the library is built for
+template void fxobjects::BasicAudioFilter<float>::calculateFilterCoeffsBatch(const AudioFilterParameters*, uint32_t, double, double*, mathAccuracy);
+template void fxobjects::BasicAudioFilter<double>::calculateFilterCoeffsBatch(const AudioFilterParameters*, uint32_t, double, double*, mathAccuracy);
+template void fxobjects::BasicAudioFilter<float>::updateFilters(BasicAudioFilter<float>* const*, uint32_t);
+template void fxobjects::BasicAudioFilter<double>::updateFilters(BasicAudioFilter<double>* const*, uint32_t);
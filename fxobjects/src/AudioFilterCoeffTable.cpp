@@ -0,0 +1,192 @@
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+#include "include/AudioFilterCoeffTable.h"
+#include "include/AudioFilter.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	bool usesQ(filterAlgorithm algorithm)
+	{
+		switch (algorithm)
+		{
+		case filterAlgorithm::kLPF2: case filterAlgorithm::kHPF2: case filterAlgorithm::kBPF2:
+		case filterAlgorithm::kBPF2Boost: case filterAlgorithm::kBSF2:
+		case filterAlgorithm::kButterBPF2: case filterAlgorithm::kButterBSF2:
+		case filterAlgorithm::kMMALPF2A: case filterAlgorithm::kMMALPF2B: case filterAlgorithm::kMMALPF2C:
+		case filterAlgorithm::kNCQParaEQ: case filterAlgorithm::kCQParaEQ: case filterAlgorithm::kAPF2:
+		case filterAlgorithm::kResonA: case filterAlgorithm::kResonB:
+		case filterAlgorithm::kMatchLP2A: case filterAlgorithm::kMatchLP2B:
+		case filterAlgorithm::kMatchBP2A: case filterAlgorithm::kMatchBP2B: case filterAlgorithm::kImpInvLP2:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool usesBoostCut(filterAlgorithm algorithm)
+	{
+		return algorithm == filterAlgorithm::kBPF2Boost || algorithm == filterAlgorithm::kLowShelf ||
+			algorithm == filterAlgorithm::kHiShelf || algorithm == filterAlgorithm::kNCQParaEQ ||
+			algorithm == filterAlgorithm::kCQParaEQ;
+	}
+
+	// --- piecewise linear log2 of a positive normal number: exponent + (mantissa - 1); exact at powers of two,
+	//     monotonic, and only bit operations, so a grid that is uniform in it costs no transcendental per lookup
+	inline double pseudoLog2(double x)
+	{
+		uint64_t bits = 0;
+		memcpy(&bits, &x, sizeof(double));
+		int64_t exponent = (int64_t)((bits >> 52) & 0x7ff) - 1023;
+
+		bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+		double mantissa = 0.0;
+		memcpy(&mantissa, &bits, sizeof(double));
+		return (double)exponent + (mantissa - 1.0);
+	}
+
+	// --- inverse of pseudoLog2( )
+	inline double pseudoExp2(double v)
+	{
+		double exponent = floor(v);
+		return ldexp(1.0 + (v - exponent), (int)exponent);
+	}
+
+	// --- linear interpolation of two coefficient arrays
+	inline void interpolateCoeffs(const double* x0, const double* x1, double frac, double* y)
+	{
+		for (uint32_t i = 0; i < numCoeffs; i++)
+			y[i] = x0[i] + frac * (x1[i] - x0[i]);
+	}
+
+	// --- split a grid coordinate into cell index and fraction; false if outside the grid (or NaN)
+	inline bool gridPosition(double u, uint32_t numPoints, uint32_t& index, double& frac)
+	{
+		if (!(u >= 0.0) || u > (double)(numPoints - 1))
+			return false;
+
+		index = (uint32_t)u;
+		if (index > numPoints - 2)
+			index = numPoints - 2;	// u on the last grid point
+		frac = u - (double)index;
+		return true;
+	}
+}
+
+bool AudioFilterCoeffTable::isTabulated(filterAlgorithm algorithm)
+{
+	// --- kRM1/kRM2 depend on k, kMMALPF2D on gr_index
+	return algorithm != filterAlgorithm::kRM1 && algorithm != filterAlgorithm::kRM2 &&
+		algorithm != filterAlgorithm::kMMALPF2D;
+}
+
+std::shared_ptr<const AudioFilterCoeffTable> AudioFilterCoeffTable::getTable(filterAlgorithm algorithm, double sampleRate)
+{
+	// --- need at least one fc cell
+	if (!isTabulated(algorithm) || !(kMaxFcRatio * sampleRate > 2.0 * kMinFc))
+		return nullptr;
+
+	static std::mutex registryMutex;
+	static std::map<std::pair<int, double>, std::shared_ptr<const AudioFilterCoeffTable>> registry;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	std::shared_ptr<const AudioFilterCoeffTable>& entry = registry[std::make_pair((int)algorithm, sampleRate)];
+	if (!entry)
+		entry = std::make_shared<const AudioFilterCoeffTable>(algorithm, sampleRate);
+	return entry;
+}
+
+AudioFilterCoeffTable::AudioFilterCoeffTable(filterAlgorithm _algorithm, double _sampleRate)
+	: algorithm(_algorithm)
+	, sampleRate(_sampleRate)
+{
+	log2MinFc = pseudoLog2(kMinFc);
+	log2MinQ = pseudoLog2(kMinQ);
+
+	numFc = (uint32_t)((pseudoLog2(kMaxFcRatio * sampleRate) - log2MinFc) * kFcPointsPerOctave) + 1;
+	if (usesQ(algorithm))
+		numQ = (uint32_t)((pseudoLog2(kMaxQ) - log2MinQ) * kQPointsPerOctave) + 1;
+	if (usesBoostCut(algorithm))
+		numBoostCut = (uint32_t)((kMaxBoostCut_dB - kMinBoostCut_dB) / kBoostCutStep_dB + 0.5) + 1;
+
+	table.resize((size_t)numBoostCut * numQ * numFc * numCoeffs);
+
+	AudioFilterParameters parameters;
+	parameters.algorithm = algorithm;
+	double* coeffs = &table[0];
+	for (uint32_t g = 0; g < numBoostCut; g++)
+	{
+		parameters.boostCut_dB = kMinBoostCut_dB + g * kBoostCutStep_dB;
+		for (uint32_t q = 0; q < numQ; q++)
+		{
+			parameters.Q = numQ > 1 ? pseudoExp2(log2MinQ + q / kQPointsPerOctave) : 0.707;
+			for (uint32_t f = 0; f < numFc; f++)
+			{
+				parameters.fc = pseudoExp2(log2MinFc + f / kFcPointsPerOctave);
+				AudioFilter::calculateFilterCoeffs(parameters, sampleRate, coeffs);
+				coeffs += numCoeffs;
+			}
+		}
+	}
+}
+
+bool AudioFilterCoeffTable::lookup(const AudioFilterParameters& parameters, double* coeffArray) const
+{
+	// --- grid cell and fractions; unused dimensions stay at cell 0
+	uint32_t f = 0, q = 0, g = 0;
+	double fcFrac = 0.0, qFrac = 0.0, boostCutFrac = 0.0;
+
+	if (!(parameters.fc > 0.0) || !gridPosition((pseudoLog2(parameters.fc) - log2MinFc) * kFcPointsPerOctave, numFc, f, fcFrac))
+		return false;
+	if (numQ > 1 && (!(parameters.Q > 0.0) ||
+		!gridPosition((pseudoLog2(parameters.Q) - log2MinQ) * kQPointsPerOctave, numQ, q, qFrac)))
+		return false;
+	if (numBoostCut > 1 && !gridPosition((parameters.boostCut_dB - kMinBoostCut_dB) / kBoostCutStep_dB, numBoostCut, g, boostCutFrac))
+		return false;
+
+	const size_t qStride = (size_t)numFc * numCoeffs;
+	const size_t boostCutStride = (size_t)numQ * qStride;
+	const double* cell = &table[g * boostCutStride + q * qStride + f * numCoeffs];
+
+	// --- interpolate along fc, then Q, then boost/cut, as far as the table has dimensions
+	double coeffs[numCoeffs];
+	interpolateCoeffs(cell, cell + numCoeffs, fcFrac, coeffs);
+
+	if (numQ > 1)
+	{
+		double upperQ[numCoeffs];
+		interpolateCoeffs(cell + qStride, cell + qStride + numCoeffs, fcFrac, upperQ);
+		interpolateCoeffs(coeffs, upperQ, qFrac, coeffs);
+
+		if (numBoostCut > 1)
+		{
+			const double* upperCell = cell + boostCutStride;
+			double upperBoostCut[numCoeffs];
+			interpolateCoeffs(upperCell, upperCell + numCoeffs, fcFrac, upperBoostCut);
+			interpolateCoeffs(upperCell + qStride, upperCell + qStride + numCoeffs, fcFrac, upperQ);
+			interpolateCoeffs(upperBoostCut, upperQ, qFrac, upperBoostCut);
+			interpolateCoeffs(coeffs, upperBoostCut, boostCutFrac, coeffs);
+		}
+	}
+	else if (numBoostCut > 1)
+	{
+		double upperBoostCut[numCoeffs];
+		interpolateCoeffs(cell + boostCutStride, cell + boostCutStride + numCoeffs, fcFrac, upperBoostCut);
+		interpolateCoeffs(coeffs, upperBoostCut, boostCutFrac, coeffs);
+	}
+
+	// --- some designs are undefined in part of the grid (e.g. kImpInvLP2 below Q = 0.5); a cell touching
+	//     those points is left to the exact design. NaN/inf survive the sum, so one check covers all seven.
+	double sum = 0.0;
+	for (uint32_t i = 0; i < numCoeffs; i++)
+		sum += coeffs[i];
+	if (!std::isfinite(sum))
+		return false;
+
+	memcpy(coeffArray, coeffs, sizeof(coeffs));
+	return true;
+}
@@ -3,107 +3,109 @@
 
 using namespace fxobjects;
 
-double Biquad::getS_value()
+template <typename SampleType>
+double BasicBiquad<SampleType>::getS_value()
 {
 	storageComponent = 0.0;
 	if (parameters.biquadCalcType == biquadAlgorithm::kDirect)
-	{
-		// --- 1)  form output y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
-		storageComponent = coeffArray[a1] * stateArray[x_z1] +
-			coeffArray[a2] * stateArray[x_z2] -
-			coeffArray[b1] * stateArray[y_z1] -
-			coeffArray[b2] * stateArray[y_z2];
-	}
+		storageComponent = BiquadKernel<biquadAlgorithm::kDirect>::storageComponent(coeffArray, stateArray);
 	else if (parameters.biquadCalcType == biquadAlgorithm::kTransposeCanonical)
-	{
-		// --- 1)  form output y(n) = a0*x(n) + stateArray[x_z1]
-		storageComponent = stateArray[x_z1];
-	}
+		storageComponent = BiquadKernel<biquadAlgorithm::kTransposeCanonical>::storageComponent(coeffArray, stateArray);
 
 	return storageComponent;
 }
 
-double Biquad::processAudioSample(double xn)
+template <typename SampleType>
+double BasicBiquad<SampleType>::processAudioSample(double xn)
 {
-	if (parameters.biquadCalcType == biquadAlgorithm::kDirect)
-	{
-		// --- 1)  form output y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
-		double yn = coeffArray[a0] * xn +
-			coeffArray[a1] * stateArray[x_z1] +
-			coeffArray[a2] * stateArray[x_z2] -
-			coeffArray[b1] * stateArray[y_z1] -
-			coeffArray[b2] * stateArray[y_z2];
-
-		// --- 2) underflow check
-		checkFloatUnderflow(yn);
-
-		// --- 3) update states
-		stateArray[x_z2] = stateArray[x_z1];
-		stateArray[x_z1] = xn;
-
-		stateArray[y_z2] = stateArray[y_z1];
-		stateArray[y_z1] = yn;
+	// --- step the coefficient ramp, if any
+	if (rampSamplesRemaining > 0)
+		advanceRamp();
 
-		// --- return value
-		return yn;
-	}
-	else if (parameters.biquadCalcType == biquadAlgorithm::kCanonical)
+	// --- decode the structure and hand off to the specialized kernel
+	switch (parameters.biquadCalcType)
 	{
-		// --- 1)  form output y(n) = a0*w(n) + m_f_a1*stateArray[x_z1] + m_f_a2*stateArray[x_z2][x_z2];
-		//
-		// --- w(n) = x(n) - b1*stateArray[x_z1] - b2*stateArray[x_z2]
-		double wn = xn - coeffArray[b1] * stateArray[x_z1] - coeffArray[b2] * stateArray[x_z2];
-
-		// --- y(n):
-		double yn = coeffArray[a0] * wn + coeffArray[a1] * stateArray[x_z1] + coeffArray[a2] * stateArray[x_z2];
-
-		// --- 2) underflow check
-		checkFloatUnderflow(yn);
-
-		// --- 3) update states
-		stateArray[x_z2] = stateArray[x_z1];
-		stateArray[x_z1] = wn;
-
-		// --- return value
-		return yn;
+	case biquadAlgorithm::kDirect:
+		return BiquadKernel<biquadAlgorithm::kDirect>::processSample(coeffArray, stateArray, (SampleType)xn);
+	case biquadAlgorithm::kCanonical:
+		return BiquadKernel<biquadAlgorithm::kCanonical>::processSample(coeffArray, stateArray, (SampleType)xn);
+	case biquadAlgorithm::kTransposeDirect:
+		return BiquadKernel<biquadAlgorithm::kTransposeDirect>::processSample(coeffArray, stateArray, (SampleType)xn);
+	case biquadAlgorithm::kTransposeCanonical:
+		return BiquadKernel<biquadAlgorithm::kTransposeCanonical>::processSample(coeffArray, stateArray, (SampleType)xn);
 	}
-	else if (parameters.biquadCalcType == biquadAlgorithm::kTransposeDirect)
-	{
-		// --- 1)  form output y(n) = a0*w(n) + stateArray[x_z1]
-		//
-		// --- w(n) = x(n) + stateArray[y_z1]
-		double wn = xn + stateArray[y_z1];
-
-		// --- y(n) = a0*w(n) + stateArray[x_z1]
-		double yn = coeffArray[a0] * wn + stateArray[x_z1];
-
-		// --- 2) underflow check
-		checkFloatUnderflow(yn);
-
-		// --- 3) update states
-		stateArray[y_z1] = stateArray[y_z2] - coeffArray[b1] * wn;
-		stateArray[y_z2] = -coeffArray[b2] * wn;
-
-		stateArray[x_z1] = stateArray[x_z2] + coeffArray[a1] * wn;
-		stateArray[x_z2] = coeffArray[a2] * wn;
+	return xn; // didn't process anything :(
+}
 
-		// --- return value
-		return yn;
+template <typename SampleType>
+template <typename BufferType>
+void BasicBiquad<SampleType>::processBlockT(const BufferType* in, BufferType* out, uint32_t n)
+{
+	// --- coefficient ramp: all but the last step run through the ramped kernel
+	if (rampSamplesRemaining > 0)
+	{
+		uint32_t rampCount = rampSamplesRemaining - 1 < n ? rampSamplesRemaining - 1 : n;
+		switch (parameters.biquadCalcType)
+		{
+		case biquadAlgorithm::kDirect:
+			processBiquadBlockRamped<biquadAlgorithm::kDirect>(coeffArray, coeffIncrement, stateArray, in, out, rampCount);
+			break;
+		case biquadAlgorithm::kCanonical:
+			processBiquadBlockRamped<biquadAlgorithm::kCanonical>(coeffArray, coeffIncrement, stateArray, in, out, rampCount);
+			break;
+		case biquadAlgorithm::kTransposeDirect:
+			processBiquadBlockRamped<biquadAlgorithm::kTransposeDirect>(coeffArray, coeffIncrement, stateArray, in, out, rampCount);
+			break;
+		case biquadAlgorithm::kTransposeCanonical:
+			processBiquadBlockRamped<biquadAlgorithm::kTransposeCanonical>(coeffArray, coeffIncrement, stateArray, in, out, rampCount);
+			break;
+		}
+		rampSamplesRemaining -= rampCount;
+		in += rampCount;
+		out += rampCount;
+		n -= rampCount;
+
+		if (n == 0)
+			return;
+
+		// --- last step lands exactly on the target
+		advanceRamp();
 	}
-	else if (parameters.biquadCalcType == biquadAlgorithm::kTransposeCanonical)
+
+	// --- decode the structure once per block
+	switch (parameters.biquadCalcType)
 	{
-		// --- 1)  form output y(n) = a0*x(n) + stateArray[x_z1]
-		double yn = coeffArray[a0] * xn + stateArray[x_z1];
+	case biquadAlgorithm::kDirect:
+		processBiquadBlock<biquadAlgorithm::kDirect>(coeffArray, stateArray, in, out, n);
+		return;
+	case biquadAlgorithm::kCanonical:
+		processBiquadBlock<biquadAlgorithm::kCanonical>(coeffArray, stateArray, in, out, n);
+		return;
+	case biquadAlgorithm::kTransposeDirect:
+		processBiquadBlock<biquadAlgorithm::kTransposeDirect>(coeffArray, stateArray, in, out, n);
+		return;
+	case biquadAlgorithm::kTransposeCanonical:
+		processBiquadBlock<biquadAlgorithm::kTransposeCanonical>(coeffArray, stateArray, in, out, n);
+		return;
+	}
 
-		// --- 2) underflow check
-		checkFloatUnderflow(yn);
+	// --- didn't process anything :(
+	for (uint32_t i = 0; i < n; i++)
+		out[i] = in[i];
+}
 
-		// --- shuffle/update
-		stateArray[x_z1] = coeffArray[a1] * xn - coeffArray[b1] * yn + stateArray[x_z2];
-		stateArray[x_z2] = coeffArray[a2] * xn - coeffArray[b2] * yn;
+template <typename SampleType>
+void BasicBiquad<SampleType>::processBlock(const float* in, float* out, uint32_t n)
+{
+	processBlockT(in, out, n);
+}
 
-		// --- return value
-		return yn;
-	}
-	return xn; // didn't process anything :(
-}
\ No newline at end of file
+template <typename SampleType>
+void BasicBiquad<SampleType>::processBlock(const double* in, double* out, uint32_t n)
+{
+	processBlockT(in, out, n);
+}
+
+// --- the two precisions the library is built for
+template class fxobjects::BasicBiquad<float>;
+template class fxobjects::BasicBiquad<double>;
@@ -0,0 +1,657 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "include/FilterDesigner.h"
+#include "include/Constants.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	using Complex = std::complex<double>;
+
+	// --- roots closer than this to the real axis are real
+	const double kRealTolerance = 1.0e-9;
+
+	// --- analog prototype for a 1 rad/sec edge: zeros, poles and |H| at DC
+	struct Prototype
+	{
+		std::vector<Complex> zeros;
+		std::vector<Complex> poles;
+		double dcGain = 1.0;
+	};
+
+	// --- the angles pi*(2k + 1)/(2N) of the Butterworth and Chebyshev poles
+	inline double poleAngle(uint32_t k, uint32_t order)
+	{
+		return kPi * (double)(2 * k + 1) / (double)(2 * order);
+	}
+
+	void butterworthPrototype(uint32_t order, Prototype& prototype)
+	{
+		for (uint32_t k = 0; k < order; k++)
+			prototype.poles.push_back(Complex(-sin(poleAngle(k, order)), cos(poleAngle(k, order))));
+	}
+
+	void chebyshevIPrototype(uint32_t order, double ripple_dB, Prototype& prototype)
+	{
+		double epsilon = sqrt(pow(10.0, ripple_dB / 10.0) - 1.0);
+		double mu = asinh(1.0 / epsilon) / (double)order;
+		for (uint32_t k = 0; k < order; k++)
+			prototype.poles.push_back(Complex(-sinh(mu) * sin(poleAngle(k, order)), cosh(mu) * cos(poleAngle(k, order))));
+
+		// --- even orders start at the bottom of the ripple
+		if (order % 2 == 0)
+			prototype.dcGain = 1.0 / sqrt(1.0 + epsilon * epsilon);
+	}
+
+	void chebyshevIIPrototype(uint32_t order, double attenuation_dB, Prototype& prototype)
+	{
+		double epsilon = 1.0 / sqrt(pow(10.0, attenuation_dB / 10.0) - 1.0);
+		double mu = asinh(1.0 / epsilon) / (double)order;
+		for (uint32_t k = 0; k < order; k++)
+		{
+			// --- the inverted Chebyshev I poles; the zeros are at j/cos, except the one at infinity for odd orders
+			double theta = poleAngle(k, order);
+			prototype.poles.push_back(1.0 / Complex(-sinh(mu) * sin(theta), cosh(mu) * cos(theta)));
+			if (2 * k + 1 != order)
+				prototype.zeros.push_back(Complex(0.0, 1.0 / cos(theta)));
+		}
+	}
+
+	// --- double-double numbers hi + lo (about 32 significant digits) from the error free transformations
+	//     TwoSum and TwoProduct (with fma), for the few evaluations that need more than double precision
+	struct DoubleDouble
+	{
+		double hi = 0.0;
+		double lo = 0.0;
+	};
+
+	inline DoubleDouble normalize(double hi, double lo)
+	{
+		double sum = hi + lo;
+		return { sum, lo - (sum - hi) };
+	}
+
+	inline DoubleDouble operator+(const DoubleDouble& x, const DoubleDouble& y)
+	{
+		double sum = x.hi + y.hi;
+		double virtualY = sum - x.hi;
+		double error = (x.hi - (sum - virtualY)) + (y.hi - virtualY);
+		return normalize(sum, error + x.lo + y.lo);
+	}
+
+	inline DoubleDouble operator-(const DoubleDouble& x) { return { -x.hi, -x.lo }; }
+	inline DoubleDouble operator-(const DoubleDouble& x, const DoubleDouble& y) { return x + (-y); }
+
+	inline DoubleDouble operator*(const DoubleDouble& x, const DoubleDouble& y)
+	{
+		double product = x.hi * y.hi;
+		double error = std::fma(x.hi, y.hi, -product);
+		return normalize(product, error + x.hi * y.lo + x.lo * y.hi);
+	}
+
+	struct ComplexDoubleDouble
+	{
+		DoubleDouble re;
+		DoubleDouble im;
+
+		ComplexDoubleDouble() {}
+		ComplexDoubleDouble(const Complex& z) : re({ z.real(), 0.0 }), im({ z.imag(), 0.0 }) {}
+		ComplexDoubleDouble(const DoubleDouble& _re, const DoubleDouble& _im) : re(_re), im(_im) {}
+
+		Complex toComplex() const { return Complex(re.hi + re.lo, im.hi + im.lo); }
+	};
+
+	inline ComplexDoubleDouble operator+(const ComplexDoubleDouble& x, const ComplexDoubleDouble& y) { return { x.re + y.re, x.im + y.im }; }
+
+	inline ComplexDoubleDouble operator*(const ComplexDoubleDouble& x, const ComplexDoubleDouble& y)
+	{
+		return { x.re * y.re - x.im * y.im, x.re * y.im + x.im * y.re };
+	}
+
+	inline ComplexDoubleDouble operator*(double x, const ComplexDoubleDouble& y)
+	{
+		DoubleDouble scale = { x, 0.0 };
+		return { scale * y.re, scale * y.im };
+	}
+
+	// --- the reverse Bessel polynomial theta(s) of an order and its derivative at s, from the three term recurrence
+	//     theta(n) = (2n - 1)*theta(n - 1) + s^2*theta(n - 2), theta(0) = 1, theta(1) = s + 1. Near a root the
+	//     value is a small difference of terms of the size of theta(|s|), which leaves double precision with a
+	//     relative root error of about 1e-2 at order 32; in double-double the roots come out to full double
+	//     precision at every order up to kMaxOrder
+	void besselPolynomial(uint32_t order, Complex s, Complex& value, Complex& derivative)
+	{
+		const ComplexDoubleDouble x(s);
+		const ComplexDoubleDouble x2 = x * x;
+		const ComplexDoubleDouble twoX = 2.0 * x;
+
+		ComplexDoubleDouble previous(Complex(1.0, 0.0));
+		ComplexDoubleDouble previousDerivative(Complex(0.0, 0.0));
+		ComplexDoubleDouble current = x + ComplexDoubleDouble(Complex(1.0, 0.0));
+		ComplexDoubleDouble currentDerivative(Complex(1.0, 0.0));
+		for (uint32_t n = 2; n <= order; n++)
+		{
+			const double k = (double)(2 * n - 1);
+			ComplexDoubleDouble next = k * current + x2 * previous;
+			ComplexDoubleDouble nextDerivative = k * currentDerivative + twoX * previous + x2 * previousDerivative;
+			previous = current;
+			previousDerivative = currentDerivative;
+			current = next;
+			currentDerivative = nextDerivative;
+		}
+
+		value = order == 0 ? Complex(1.0, 0.0) : current.toComplex();
+		derivative = order == 0 ? Complex(0.0, 0.0) : currentDerivative.toComplex();
+	}
+
+	// --- roots of the reverse Bessel polynomial by Aberth iteration (Newton steps with implicit deflation of the
+	//     other roots), started on a circle of radius |theta(0)|^(1/N), the geometric mean of the root magnitudes;
+	//     returns false if it does not converge
+	bool besselRoots(uint32_t order, std::vector<Complex>& roots)
+	{
+		// --- theta(0) = (2N)!/(2^N N!)
+		double logConstant = lgamma(2.0 * order + 1.0) - (double)order * log(2.0) - lgamma((double)order + 1.0);
+		double radius = exp(logConstant / (double)order);
+
+		// --- the start must not be symmetric about the real axis, or conjugate pairs could not separate
+		roots.resize(order);
+		for (uint32_t k = 0; k < order; k++)
+			roots[k] = std::polar(radius, 2.0 * kPi * ((double)k + 0.25) / (double)order + 0.4);
+
+		for (uint32_t iteration = 0; iteration < 500; iteration++)
+		{
+			double maxStep = 0.0;
+			for (uint32_t i = 0; i < order; i++)
+			{
+				Complex value = 0.0;
+				Complex derivative = 0.0;
+				besselPolynomial(order, roots[i], value, derivative);
+				if (value == 0.0)
+					continue;
+
+				Complex ratio = value / derivative;
+				Complex repulsion = 0.0;
+				for (uint32_t j = 0; j < order; j++)
+				{
+					if (j != i)
+						repulsion += 1.0 / (roots[i] - roots[j]);
+				}
+
+				Complex step = ratio / (1.0 - ratio * repulsion);
+				roots[i] -= step;
+				maxStep = fmax(maxStep, std::abs(step) / std::abs(roots[i]));
+			}
+
+			// --- the convergence is cubic, so a step this small leaves an error at the rounding level
+			if (maxStep < 1.0e-14)
+				return true;
+		}
+		return false;
+	}
+
+	// --- |H(jw)|^2 of an all pole prototype with H(0) = 1
+	double allPoleMagnitudeSquared(const std::vector<Complex>& poles, double w)
+	{
+		double magnitudeSquared = 1.0;
+		for (const Complex& pole : poles)
+			magnitudeSquared *= std::norm(pole) / std::norm(Complex(0.0, w) - pole);
+		return magnitudeSquared;
+	}
+
+	void besselPrototype(uint32_t order, Prototype& prototype)
+	{
+		std::vector<Complex> roots;
+		if (!besselRoots(order, roots))
+			return;
+
+		// --- exact conjugate symmetry: the roots sorted by imaginary part are N/2 lower half plane roots, the
+		//     real root for odd orders, then the N/2 conjugates; keep the upper half and the real root
+		//     (checked; a failed check leaves no poles and the design is rejected)
+		std::sort(roots.begin(), roots.end(), [](const Complex& x, const Complex& y) { return x.imag() < y.imag(); });
+		for (uint32_t k = 0; k < order / 2; k++)
+		{
+			if (std::abs(roots[k] - std::conj(roots[order - 1 - k])) > kRealTolerance * std::abs(roots[k]))
+				return;
+		}
+		if (order % 2 == 1 && fabs(roots[order / 2].imag()) > kRealTolerance * std::abs(roots[order / 2]))
+			return;
+
+		for (uint32_t k = order - order / 2; k < order; k++)
+		{
+			prototype.poles.push_back(roots[k]);
+			prototype.poles.push_back(std::conj(roots[k]));
+		}
+		if (order % 2 == 1)
+			prototype.poles.push_back(Complex(roots[order / 2].real(), 0.0));
+
+		// --- move the -3 dB point from the delay normalized design to 1 rad/sec
+		double low = 0.0;
+		double high = 1.0;
+		while (allPoleMagnitudeSquared(prototype.poles, high) > 0.5)
+			high *= 2.0;
+		for (uint32_t i = 0; i < 100; i++)
+		{
+			double w = 0.5 * (low + high);
+			if (allPoleMagnitudeSquared(prototype.poles, w) > 0.5)
+				low = w;
+			else
+				high = w;
+		}
+
+		double w3dB = 0.5 * (low + high);
+		for (Complex& pole : prototype.poles)
+			pole /= w3dB;
+	}
+
+	// --- Jacobi elliptic functions with the argument normalized to the quarter period K, evaluated with the
+	//     Landen transformation (S. J. Orfanidis, "Lecture Notes on Elliptic Filter Design"); the modulus is
+	//     passed with its complement, which is the accurate one when k is close to 1
+	std::vector<double> landenSequence(double k, double kPrime)
+	{
+		std::vector<double> sequence;
+		for (uint32_t i = 0; i < 16 && k > 1.0e-16; i++)
+		{
+			double next = k / (1.0 + kPrime);
+			next *= next;
+			kPrime = 2.0 * sqrt(kPrime) / (1.0 + kPrime);
+			k = next;
+			sequence.push_back(k);
+		}
+		return sequence;
+	}
+
+	// --- cd(uK, k)
+	Complex cde(Complex u, double k, double kPrime)
+	{
+		std::vector<double> sequence = landenSequence(k, kPrime);
+		Complex w = std::cos(u * (kPi / 2.0));
+		for (size_t i = sequence.size(); i-- > 0;)
+			w = (1.0 + sequence[i]) * w / (1.0 + sequence[i] * w * w);
+		return w;
+	}
+
+	// --- sn(uK, k)
+	Complex sne(Complex u, double k, double kPrime)
+	{
+		std::vector<double> sequence = landenSequence(k, kPrime);
+		Complex w = std::sin(u * (kPi / 2.0));
+		for (size_t i = sequence.size(); i-- > 0;)
+			w = (1.0 + sequence[i]) * w / (1.0 + sequence[i] * w * w);
+		return w;
+	}
+
+	// --- inverse of sne( )
+	Complex asne(Complex w, double k, double kPrime)
+	{
+		std::vector<double> sequence = landenSequence(k, kPrime);
+		double previous = k;
+		for (double modulus : sequence)
+		{
+			w = w / (1.0 + std::sqrt(1.0 - w * w * (previous * previous))) * (2.0 / (1.0 + modulus));
+			previous = modulus;
+		}
+		return std::asin(w) * (2.0 / kPi);
+	}
+
+	void ellipticPrototype(uint32_t order, double ripple_dB, double attenuation_dB, Prototype& prototype)
+	{
+		double epsilonPass = sqrt(pow(10.0, ripple_dB / 10.0) - 1.0);
+		double epsilonStop = sqrt(pow(10.0, attenuation_dB / 10.0) - 1.0);
+		double k1 = epsilonPass / epsilonStop;
+		double k1Prime = sqrt(1.0 - k1 * k1);
+		uint32_t pairs = order / 2;
+
+		// --- degree equation: the selectivity k = (passband edge)/(stopband edge) that order, ripple and
+		//     attenuation allow; computed as its complement
+		double kPrime = pow(k1Prime, (double)order);
+		for (uint32_t i = 1; i <= pairs; i++)
+		{
+			double s = sne((double)(2 * i - 1) / (double)order, k1Prime, k1).real();
+			kPrime *= s * s * s * s;
+		}
+		double k = sqrt(1.0 - kPrime * kPrime);
+
+		// --- v0 places the poles so that the passband ripple is epsilonPass
+		double v0 = (-Complex(0.0, 1.0) * asne(Complex(0.0, 1.0 / epsilonPass), k1, k1Prime)).real() / (double)order;
+
+		for (uint32_t i = 1; i <= pairs; i++)
+		{
+			double u = (double)(2 * i - 1) / (double)order;
+			Complex zero = Complex(0.0, 1.0) / (k * cde(u, k, kPrime));
+			Complex pole = Complex(0.0, 1.0) * cde(Complex(u, -v0), k, kPrime);
+			prototype.zeros.push_back(Complex(0.0, fabs(zero.imag())));
+			prototype.zeros.push_back(Complex(0.0, -fabs(zero.imag())));
+			prototype.poles.push_back(pole);
+			prototype.poles.push_back(std::conj(pole));
+		}
+
+		if (order % 2 == 1)
+			prototype.poles.push_back(Complex((Complex(0.0, 1.0) * sne(Complex(0.0, v0), k, kPrime)).real(), 0.0));
+		else
+			prototype.dcGain = 1.0 / sqrt(1.0 + epsilonPass * epsilonPass);
+	}
+
+	// --- one second order section: two zeros and two poles (or one of each, a2 = b2 = 0)
+	struct Section
+	{
+		Complex zeros[2];
+		Complex poles[2];
+		uint32_t order = 2;
+	};
+
+	// --- remove roots[index] from roots
+	inline Complex takeRoot(std::vector<Complex>& roots, size_t index)
+	{
+		Complex root = roots[index];
+		roots.erase(roots.begin() + index);
+		return root;
+	}
+
+	// --- index of the root in roots nearest to target
+	size_t nearestRoot(const std::vector<Complex>& roots, Complex target)
+	{
+		size_t nearest = 0;
+		for (size_t i = 1; i < roots.size(); i++)
+		{
+			if (std::abs(roots[i] - target) < std::abs(roots[nearest] - target))
+				nearest = i;
+		}
+		return nearest;
+	}
+
+	// --- split conjugate symmetric roots into upper half plane representatives and real roots
+	void splitRoots(const std::vector<Complex>& roots, std::vector<Complex>& complexRoots, std::vector<Complex>& realRoots)
+	{
+		for (const Complex& root : roots)
+		{
+			if (fabs(root.imag()) <= kRealTolerance * fmax(1.0, std::abs(root)))
+				realRoots.push_back(Complex(root.real(), 0.0));
+			else if (root.imag() > 0.0)
+				complexRoots.push_back(root);
+		}
+	}
+
+	// --- pair the digital poles and zeros into sections: the pole (pair) nearest the unit circle first, with
+	//     the zeros nearest to it; returned in processing order, i.e. reversed
+	std::vector<Section> pairSections(const std::vector<Complex>& zeros, const std::vector<Complex>& poles)
+	{
+		std::vector<Complex> complexPoles, realPoles, complexZeros, realZeros;
+		splitRoots(poles, complexPoles, realPoles);
+		splitRoots(zeros, complexZeros, realZeros);
+
+		std::vector<Section> sections;
+		while (complexPoles.size() + realPoles.size() > 0)
+		{
+			// --- the remaining pole with the largest radius
+			bool complexPole = false;
+			size_t index = 0;
+			double radius = -1.0;
+			for (size_t i = 0; i < complexPoles.size(); i++)
+			{
+				if (std::abs(complexPoles[i]) > radius)
+				{
+					radius = std::abs(complexPoles[i]);
+					index = i;
+					complexPole = true;
+				}
+			}
+			for (size_t i = 0; i < realPoles.size(); i++)
+			{
+				if (std::abs(realPoles[i]) > radius)
+				{
+					radius = std::abs(realPoles[i]);
+					index = i;
+					complexPole = false;
+				}
+			}
+
+			Section section;
+			if (complexPole)
+			{
+				section.poles[0] = takeRoot(complexPoles, index);
+				section.poles[1] = std::conj(section.poles[0]);
+			}
+			else
+			{
+				section.poles[0] = takeRoot(realPoles, index);
+				if (realPoles.empty())
+					section.order = 1;
+				else
+				{
+					// --- the next largest real pole
+					size_t next = 0;
+					for (size_t i = 1; i < realPoles.size(); i++)
+					{
+						if (std::abs(realPoles[i]) > std::abs(realPoles[next]))
+							next = i;
+					}
+					section.poles[1] = takeRoot(realPoles, next);
+				}
+			}
+
+			if (section.order == 1)
+				section.zeros[0] = takeRoot(realZeros, nearestRoot(realZeros, section.poles[0]));
+			else
+			{
+				// --- a conjugate pair or two real zeros, whichever is nearer; the real zeros keep their parity
+				//     with the real poles, so a first order section left for later still finds one
+				bool useComplex = realZeros.size() < 2;
+				if (!useComplex && !complexZeros.empty())
+				{
+					Complex nearestComplex = complexZeros[nearestRoot(complexZeros, section.poles[0])];
+					Complex nearestReal = realZeros[nearestRoot(realZeros, section.poles[0])];
+					useComplex = std::abs(nearestComplex - section.poles[0]) < std::abs(nearestReal - section.poles[0]);
+				}
+
+				if (useComplex)
+				{
+					section.zeros[0] = takeRoot(complexZeros, nearestRoot(complexZeros, section.poles[0]));
+					section.zeros[1] = std::conj(section.zeros[0]);
+				}
+				else
+				{
+					section.zeros[0] = takeRoot(realZeros, nearestRoot(realZeros, section.poles[0]));
+					section.zeros[1] = takeRoot(realZeros, nearestRoot(realZeros, section.poles[1]));
+				}
+			}
+			sections.push_back(section);
+		}
+
+		// --- lowest Q first
+		return std::vector<Section>(sections.rbegin(), sections.rend());
+	}
+
+	bool designPrototype(const FilterDesignParameters& parameters, Prototype& prototype)
+	{
+		switch (parameters.prototype)
+		{
+		case filterPrototype::kButterworth:
+			butterworthPrototype(parameters.order, prototype);
+			return true;
+		case filterPrototype::kChebyshevI:
+			chebyshevIPrototype(parameters.order, parameters.passbandRipple_dB, prototype);
+			return true;
+		case filterPrototype::kChebyshevII:
+			chebyshevIIPrototype(parameters.order, parameters.stopbandAttenuation_dB, prototype);
+			return true;
+		case filterPrototype::kBessel:
+			besselPrototype(parameters.order, prototype);
+			return true;
+		case filterPrototype::kElliptic:
+			ellipticPrototype(parameters.order, parameters.passbandRipple_dB, parameters.stopbandAttenuation_dB, prototype);
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+uint32_t FilterDesigner::getNumSections(const FilterDesignParameters& parameters)
+{
+	if (parameters.bandType == filterBandType::kBandpass || parameters.bandType == filterBandType::kBandstop)
+		return parameters.order;
+	return (parameters.order + 1) / 2;
+}
+
+bool FilterDesigner::designFilter(const FilterDesignParameters& parameters, double sampleRate, double* coeffArrays)
+{
+	// --- parameter checks
+	if (parameters.order == 0 || parameters.order > kMaxOrder || sampleRate <= 0.0)
+		return false;
+	if ((parameters.prototype == filterPrototype::kChebyshevI || parameters.prototype == filterPrototype::kElliptic) &&
+		parameters.passbandRipple_dB <= 0.0)
+		return false;
+	if ((parameters.prototype == filterPrototype::kChebyshevII || parameters.prototype == filterPrototype::kElliptic) &&
+		parameters.stopbandAttenuation_dB <= 0.0)
+		return false;
+	if (parameters.prototype == filterPrototype::kElliptic && parameters.passbandRipple_dB >= parameters.stopbandAttenuation_dB)
+		return false;
+
+	const bool bandFilter = parameters.bandType == filterBandType::kBandpass || parameters.bandType == filterBandType::kBandstop;
+	double fLow = parameters.fc;
+	double fHigh = parameters.fc;
+	if (bandFilter)
+	{
+		if (parameters.Q <= 0.0)
+			return false;
+
+		// --- edges with fc = sqrt(fLow*fHigh) and fHigh - fLow = fc/Q
+		double halfBandwidth = 0.5 / parameters.Q;
+		fLow = parameters.fc * (sqrt(1.0 + halfBandwidth * halfBandwidth) - halfBandwidth);
+		fHigh = fLow + parameters.fc / parameters.Q;
+	}
+	if (fLow <= 0.0 || fHigh >= 0.5 * sampleRate)
+		return false;
+
+	// --- a Bessel design whose root finder did not converge has the wrong pole count
+	Prototype prototype;
+	if (!designPrototype(parameters, prototype) || prototype.poles.size() != parameters.order)
+		return false;
+
+	// --- prewarped edges, with the bilinear transform s = (1 - z^-1)/(1 + z^-1) (K = 1)
+	double wLow = tan(kPi * fLow / sampleRate);
+	double wHigh = tan(kPi * fHigh / sampleRate);
+	double w0 = sqrt(wLow * wHigh);
+	double halfBandwidth = 0.5 * (wHigh - wLow);
+
+	// --- frequency transformation of the prototype
+	std::vector<Complex> zeros;
+	std::vector<Complex> poles;
+	size_t zerosAtInfinity = prototype.poles.size() - prototype.zeros.size();
+	Complex reference = 1.0;
+	switch (parameters.bandType)
+	{
+	case filterBandType::kLowpass:
+		for (const Complex& zero : prototype.zeros)
+			zeros.push_back(zero * wLow);
+		for (const Complex& pole : prototype.poles)
+			poles.push_back(pole * wLow);
+		break;
+
+	case filterBandType::kHighpass:
+		for (const Complex& zero : prototype.zeros)
+			zeros.push_back(wLow / zero);
+		for (const Complex& pole : prototype.poles)
+			poles.push_back(wLow / pole);
+		zeros.insert(zeros.end(), zerosAtInfinity, Complex(0.0, 0.0));
+		reference = -1.0;
+		break;
+
+	case filterBandType::kBandpass:
+	case filterBandType::kBandstop:
+	{
+		// --- s -> (s^2 + w0^2)/(s*BW) or s*BW/(s^2 + w0^2): each root r becomes the two roots of
+		//     s^2 - 2*b*s + w0^2 with b = r*BW/2 or (BW/2)/r
+		const bool bandpass = parameters.bandType == filterBandType::kBandpass;
+		auto transform = [&](const Complex& root, std::vector<Complex>& roots)
+		{
+			Complex b = bandpass ? root * halfBandwidth : halfBandwidth / root;
+			Complex d = std::sqrt(b * b - w0 * w0);
+			roots.push_back(b + d);
+			roots.push_back(b - d);
+		};
+		for (const Complex& zero : prototype.zeros)
+			transform(zero, zeros);
+		for (const Complex& pole : prototype.poles)
+			transform(pole, poles);
+
+		if (bandpass)
+		{
+			// --- the zeros at infinity go half to DC, half to infinity
+			zeros.insert(zeros.end(), zerosAtInfinity, Complex(0.0, 0.0));
+			reference = std::polar(1.0, 2.0 * atan(w0));
+		}
+		else
+		{
+			// --- and to the notch frequency for a band stop
+			for (size_t i = 0; i < zerosAtInfinity; i++)
+			{
+				zeros.push_back(Complex(0.0, w0));
+				zeros.push_back(Complex(0.0, -w0));
+			}
+		}
+		break;
+	}
+
+	default:
+		return false;
+	}
+
+	// --- bilinear transform z = (1 + s)/(1 - s); zeros at infinity land on Nyquist
+	for (Complex& zero : zeros)
+		zero = (1.0 + zero) / (1.0 - zero);
+	for (Complex& pole : poles)
+		pole = (1.0 + pole) / (1.0 - pole);
+	zeros.insert(zeros.end(), poles.size() - zeros.size(), Complex(-1.0, 0.0));
+
+	std::vector<Section> sections = pairSections(zeros, poles);
+	if (sections.size() != getNumSections(parameters))
+		return false;
+
+	// --- equal share of the passband gain per section, at the reference frequency
+	double sectionGain = pow(prototype.dcGain, 1.0 / (double)sections.size());
+	Complex referenceDelay = 1.0 / reference;
+	Complex totalPhase = 1.0;
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		const Section& section = sections[i];
+		double* coeffs = &coeffArrays[i * numCoeffs];
+		if (section.order == 1)
+		{
+			coeffs[a1] = -section.zeros[0].real();
+			coeffs[a2] = 0.0;
+			coeffs[b1] = -section.poles[0].real();
+			coeffs[b2] = 0.0;
+		}
+		else
+		{
+			coeffs[a1] = -(section.zeros[0] + section.zeros[1]).real();
+			coeffs[a2] = (section.zeros[0] * section.zeros[1]).real();
+			coeffs[b1] = -(section.poles[0] + section.poles[1]).real();
+			coeffs[b2] = (section.poles[0] * section.poles[1]).real();
+		}
+
+		Complex response = (1.0 + referenceDelay * (coeffs[a1] + referenceDelay * coeffs[a2])) /
+			(1.0 + referenceDelay * (coeffs[b1] + referenceDelay * coeffs[b2]));
+		double scale = sectionGain / std::abs(response);
+		coeffs[a0] = scale;
+		coeffs[a1] *= scale;
+		coeffs[a2] *= scale;
+		coeffs[c0] = 1.0;
+		coeffs[d0] = 0.0;
+		totalPhase *= response / std::abs(response);
+	}
+
+	// --- a positive passband
+	if (totalPhase.real() < 0.0)
+	{
+		coeffArrays[a0] = -coeffArrays[a0];
+		coeffArrays[a1] = -coeffArrays[a1];
+		coeffArrays[a2] = -coeffArrays[a2];
+	}
+
+	return true;
+}
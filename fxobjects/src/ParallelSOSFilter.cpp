@@ -0,0 +1,174 @@
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "include/ParallelSOSFilter.h"
+
+using namespace fxobjects;
+
+namespace
+{
+	using Complex = std::complex<double>;
+
+	// --- poles this close to the origin are at the origin, and poles closer than kMinPoleSpacing are repeated
+	const double kOriginTolerance = 1.0e-12;
+	const double kMinPoleSpacing = 1.0e-9;
+
+	// --- folded section { a0, a1, a2, b1, b2 } and its poles, the roots of z^2 + b1*z + b2
+	struct CascadeSection
+	{
+		double numerator[3] = { 0.0, 0.0, 0.0 };
+		double b1 = 0.0;
+		double b2 = 0.0;
+		Complex poles[2];
+		uint32_t numPoles = 0;	///< poles away from the origin
+		bool conjugatePair = false;
+	};
+
+	// --- the roots of z^2 + b1*z + b2 away from the origin; returns the number of roots at the origin
+	uint32_t sectionPoles(CascadeSection& section)
+	{
+		double discriminant = section.b1 * section.b1 - 4.0 * section.b2;
+		if (discriminant < 0.0)
+		{
+			double imag = 0.5 * sqrt(-discriminant);
+			section.poles[0] = Complex(-0.5 * section.b1, imag);
+			section.poles[1] = Complex(-0.5 * section.b1, -imag);
+			section.numPoles = 2;
+			section.conjugatePair = true;
+			return 0;
+		}
+
+		// --- real roots without cancellation: q = -(b1 + sign(b1)*sqrt(D))/2, roots q and b2/q
+		double q = -0.5 * (section.b1 + copysign(sqrt(discriminant), section.b1));
+		double roots[2] = { q, q != 0.0 ? section.b2 / q : 0.0 };
+		uint32_t atOrigin = 0;
+		for (double root : roots)
+		{
+			if (fabs(root) <= kOriginTolerance)
+				atOrigin++;
+			else
+				section.poles[section.numPoles++] = Complex(root, 0.0);
+		}
+		return atOrigin;
+	}
+}
+
+bool fxobjects::cascadeToParallel(const double* cascadeCoeffs, uint32_t numSections, double* parallelCoeffs, uint32_t& numParallelSections)
+{
+	if (numSections == 0)
+		return false;
+
+	// --- fold d0 + c0*H(z) into the numerator, as BiquadCascade, and find the poles
+	std::vector<CascadeSection> sections(numSections);
+	std::vector<Complex> poles;
+	uint32_t polesAtOrigin = 0;
+	for (uint32_t i = 0; i < numSections; i++)
+	{
+		const double* coeffs = &cascadeCoeffs[i * numCoeffs];
+		CascadeSection& section = sections[i];
+		section.numerator[0] = coeffs[d0] + coeffs[c0] * coeffs[a0];
+		section.numerator[1] = coeffs[d0] * coeffs[b1] + coeffs[c0] * coeffs[a1];
+		section.numerator[2] = coeffs[d0] * coeffs[b2] + coeffs[c0] * coeffs[a2];
+		section.b1 = coeffs[b1];
+		section.b2 = coeffs[b2];
+
+		polesAtOrigin += sectionPoles(section);
+		for (uint32_t k = 0; k < section.numPoles; k++)
+			poles.push_back(section.poles[k]);
+	}
+
+	// --- a direct term of more than two delays would not fit one section
+	if (polesAtOrigin > 2)
+		return false;
+
+	for (size_t i = 0; i < poles.size(); i++)
+	{
+		for (size_t j = i + 1; j < poles.size(); j++)
+		{
+			if (std::abs(poles[i] - poles[j]) < kMinPoleSpacing)
+				return false;
+		}
+	}
+
+	// --- H(z) = prod (a0*z^2 + a1*z + a2)/(z^2 + b1*z + b2) is proper in z, so
+	//     H(z) = h(0) + (terms at the origin) + sum g/(z - p), g = residue at p
+	auto residue = [&](const Complex& pole)
+	{
+		Complex value = 1.0;
+		for (const CascadeSection& section : sections)
+			value *= (section.numerator[0] * pole + section.numerator[1]) * pole + section.numerator[2];
+		for (const Complex& other : poles)
+		{
+			if (other != pole)
+				value /= pole - other;
+		}
+		for (uint32_t i = 0; i < polesAtOrigin; i++)
+			value /= pole;
+		return value;
+	};
+
+	// --- the first three impulse response samples of the cascade (transposed canonical, as processed)
+	double h[3] = { 1.0, 0.0, 0.0 };
+	for (const CascadeSection& section : sections)
+	{
+		double y[3] = { 0.0, 0.0, 0.0 };
+		for (uint32_t n = 0; n < 3; n++)
+		{
+			y[n] = section.numerator[0] * h[n];
+			if (n >= 1)
+				y[n] += section.numerator[1] * h[n - 1] - section.b1 * y[n - 1];
+			if (n >= 2)
+				y[n] += section.numerator[2] * h[n - 2] - section.b2 * y[n - 2];
+		}
+		for (uint32_t n = 0; n < 3; n++)
+			h[n] = y[n];
+	}
+
+	// --- one parallel section per cascade section: g*z^-1/(1 - p*z^-1) for each pole, combined over the
+	//     section's conjugate or real pair; the sums of g*p^(n - 1) give the direct term below
+	std::vector<double> sectionCoeffs;
+	Complex poleSum[2] = { 0.0, 0.0 };
+	for (const CascadeSection& section : sections)
+	{
+		if (section.numPoles == 0)
+			continue;
+
+		Complex g[2];
+		for (uint32_t k = 0; k < section.numPoles; k++)
+		{
+			g[k] = section.conjugatePair && k == 1 ? std::conj(g[0]) : residue(section.poles[k]);
+			poleSum[0] += g[k];
+			poleSum[1] += g[k] * section.poles[k];
+		}
+
+		double coeffs[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+		if (section.numPoles == 1)
+		{
+			// --- g*z^-1/(1 - p*z^-1)
+			coeffs[a1] = g[0].real();
+			coeffs[b1] = -section.poles[0].real();
+		}
+		else
+		{
+			// --- z^-1*(g0 + g1 - (g0*p1 + g1*p0)*z^-1)/((1 - p0*z^-1)(1 - p1*z^-1))
+			coeffs[a1] = (g[0] + g[1]).real();
+			coeffs[a2] = -(g[0] * section.poles[1] + g[1] * section.poles[0]).real();
+			coeffs[b1] = -(section.poles[0] + section.poles[1]).real();
+			coeffs[b2] = (section.poles[0] * section.poles[1]).real();
+		}
+		sectionCoeffs.insert(sectionCoeffs.end(), coeffs, coeffs + numCoeffs);
+	}
+
+	// --- direct term h(0) + q1*z^-1 + q2*z^-2, with q(n) = h(n) - sum g*p^(n - 1) for each pole at the origin
+	double direct[numCoeffs] = { h[0], 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+	if (polesAtOrigin >= 1)
+		direct[a1] = h[1] - poleSum[0].real();
+	if (polesAtOrigin >= 2)
+		direct[a2] = h[2] - poleSum[1].real();
+	sectionCoeffs.insert(sectionCoeffs.end(), direct, direct + numCoeffs);
+
+	numParallelSections = (uint32_t)(sectionCoeffs.size() / numCoeffs);
+	for (size_t i = 0; i < sectionCoeffs.size(); i++)
+		parallelCoeffs[i] = sectionCoeffs[i];
+	return true;
+}
@@ -24,6 +24,8 @@ Control I/F:
 #include "include/WdfParallelAdaptor.h"
 #include "include/WdfSeriesTerminatedAdaptor.h"
 #include "include/IComponentAdaptor.h"
+#include "include/FastMath.h"
+#include "include/FrequencyResponse.h"
 
 using namespace fxobjects;
 
@@ -78,17 +80,17 @@ public:
 		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
 
 		// --- set source resistance
-		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+		seriesAdaptor_L1.setSourceResistance(sourceResistance); // --- Rs = 600
 
 		// --- set terminal resistance
-		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+		seriesTerminatedAdaptor_L2.setTerminalResistance(loadResistance); // --- Rload = 600
 	}
 
 	void calculateNewComponentValues(double _fc)
 	{
 		// frequency warping
 		double arg = (kPi * _fc) / sampleRate;
-		_fc = _fc * (tan(arg) / arg);
+		_fc = _fc * (fastTan(arg, designAccuracy) / arg);
 
 		// frequency scaling:
 		// calculate new values for L1, L2, C1
@@ -100,12 +102,67 @@ public:
 		parallelAdaptor_C1.setComponentValue(C1_value / _fc);
 		seriesTerminatedAdaptor_L2.setComponentValue(L2_newValue);
 
+		// --- for getFrequencyResponse( )
+		L1_current = L1_newValue;
+		C1_current = C1_value / _fc;
+		L2_current = L2_newValue;
+
 		// if not called, the values are not updated inside the components
 		// reset() only sets sampleRate after createWDF()
 		// and the cutoff frequency will not change
 		seriesAdaptor_L1.initializeAdaptorChain();
 	}
 
+	/** set the math tier for the frequency warping, see FastMath.h; takes effect at the next calculateNewComponentValues( ) */
+	/**
+	\param _accuracy kExact (libm), kHigh (about 1e-7) or kLow (about 1e-4 relative error)
+	*/
+	void setMathAccuracy(mathAccuracy _accuracy) { designAccuracy = _accuracy; }
+
+	/** get the math tier */
+	mathAccuracy getMathAccuracy() { return designAccuracy; }
+
+	/** magnitude and phase of the current component values, evaluated from the ladder's transfer function
+		H(s) = 2*RL/((Rs + L1*s)*(1 + C1*s*(RL + L2*s)) + RL + L2*s) (Rs = RL = 600; the WDF output is twice the
+		load voltage, 0 dB at DC): the WDF capacitor and inductors are bilinear (trapezoidal) models, so the
+		response is H(s) at s = j*2*fs*tan(w/2). The prototype is third order, so it is evaluated directly rather
+		than as a biquad. See FrequencyResponse.h. */
+	/**
+	\param frequencies count frequencies in Hz
+	\param count number of frequencies
+	\param magnitude_dB receives count magnitudes in dB
+	\param phase receives count phases in radians; may be nullptr
+	*/
+	void getFrequencyResponse(const double* frequencies, uint32_t count, double* magnitude_dB, double* phase = nullptr)
+	{
+		// --- denominator d3*s^3 + d2*s^2 + d1*s + d0
+		const double d0 = sourceResistance + loadResistance;
+		const double d1 = sourceResistance * C1_current * loadResistance + L1_current + L2_current;
+		const double d2 = sourceResistance * C1_current * L2_current + L1_current * C1_current * loadResistance;
+		const double d3 = L1_current * C1_current * L2_current;
+
+		double real[BLOCK_SCRATCH_LENGTH];
+		double imag[BLOCK_SCRATCH_LENGTH];
+		for (uint32_t offset = 0; offset < count; offset += BLOCK_SCRATCH_LENGTH)
+		{
+			uint32_t n = count - offset < BLOCK_SCRATCH_LENGTH ? count - offset : BLOCK_SCRATCH_LENGTH;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				// --- H(j*omega) = 2*RL/((d0 - d2*omega^2) + j*(d1*omega - d3*omega^3))
+				double omega = 2.0 * sampleRate * tan(kPi * frequencies[offset + i] / sampleRate);
+				double omega2 = omega * omega;
+				double denReal = d0 - d2 * omega2;
+				double denImag = omega * (d1 - d3 * omega2);
+				double scale = 2.0 * loadResistance / (denReal * denReal + denImag * denImag);
+				real[i] = denReal * scale;
+				imag[i] = -denImag * scale;
+			}
+			responseMagnitude_dB(real, imag, n, magnitude_dB + offset);
+			if (phase)
+				responsePhase(real, imag, n, phase + offset);
+		}
+	}
+
 protected:
 	// --- three adapters
 	WdfSeriesAdaptor seriesAdaptor_L1;			///< adaptor for L1
@@ -117,6 +174,15 @@ protected:
 	double C1_value = 0.5305e-3;	// 0.53 uF
 	double L2_value = 95.49;		// 95.5 mH
 
+	// --- current (scaled) component values, for getFrequencyResponse( )
+	double L1_current = 95.49;
+	double C1_current = 0.5305e-3;
+	double L2_current = 95.49;
+
+	double sourceResistance = 600.0;	///< Rs
+	double loadResistance = 600.0;		///< Rload
+
 	// if not set here, no audio output on startup
 	double sampleRate = 44100.0;
+	mathAccuracy designAccuracy = mathAccuracy::kExact;	///< math tier for the frequency warping
 };
\ No newline at end of file
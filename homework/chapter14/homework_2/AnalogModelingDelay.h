@@ -25,16 +25,30 @@
  * 
  * @see AudioDelay.h
  * @see AudioFilter.h
+ * @see FixedAudioFilter.h
  */
 
 #pragma once
 #include "include/AudioDelay.h"
 #include "include/AudioFilter.h"
+#include "include/FixedAudioFilter.h"
 
-#define CUTOFF 3000.0; // fc in Hz
+#define CUTOFF 3000.0 // fc in Hz
 
 namespace fxobjects
 {
+    /**
+     * @brief Fixed design of the feedback low-pass filter; the coefficients for 48kHz are computed at compile time
+     */
+    struct BBDLoopFilter
+    {
+        static constexpr filterAlgorithm algorithm = filterAlgorithm::kLPF1;
+        static constexpr double fc = CUTOFF;
+        static constexpr double Q = 0.707;
+        static constexpr double boostCut_dB = 0.0;
+        static constexpr double sampleRate = 48000.0;
+    };
+
     class AnalogModelingDelay : public IAudioSignalProcessor
     {
     public:
@@ -54,7 +68,8 @@ namespace fxobjects
          * @return bool True if reset was successful, false otherwise
          * 
          * @note The low-pass filter is configured with a first-order low-pass response (12dB/octave)
-         * and the cutoff frequency defined by CUTOFF (3000Hz by default).
+         * and the cutoff frequency defined by CUTOFF (3000Hz by default). At 48kHz it runs on the
+         * compile-time coefficients; any other rate designs it once here.
          */
         virtual bool reset(double _sampleRate)
         {
@@ -71,9 +86,6 @@ namespace fxobjects
 
             // Reinitialize the low-pass filter for analog modeling
             mAudioFilter.reset(_sampleRate);
-            mAudioFilterParameters.algorithm = filterAlgorithm::kLPF1;
-            mAudioFilterParameters.fc = CUTOFF;
-            mAudioFilter.setParameters(mAudioFilterParameters); // Updates filter coefficients
 
             return true;
         }
@@ -358,7 +370,6 @@ namespace fxobjects
         CircularBuffer<double> delayBuffer_R;	///< RIGHT delay buffer of doubles
 
         // (Low Pass) Filter for Analog Modeling
-        AudioFilter mAudioFilter;                     ///< Low-pass filter for analog modeling in feedback path
-        AudioFilterParameters mAudioFilterParameters;  ///< Configuration parameters for the analog modeling filter
+        FixedAudioFilter<BBDLoopFilter> mAudioFilter;  ///< Low-pass filter for analog modeling in feedback path
     };
 } // namespace fxobjects
\ No newline at end of file
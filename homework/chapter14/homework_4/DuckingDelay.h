@@ -180,12 +180,18 @@ public:
 
 		float frames[2] = { 0.0, 0.0 }; // array for left and right frame to process in AudioDelay processAudioFrame()
 
+		// attack and release are taken once per block, so the detector recalculates its time constants
+		// (two exp() calls) at most once per block instead of on every sample while they are smoothed
+		if (nFrames > 0)
+		{
+			mEnvelopeFollowerParameters.attackTime_mSec = envAttack[0];
+			mEnvelopeFollowerParameters.releaseTime_mSec = envRelease[0];
+		}
+
 		for (int s = 0; s < nFrames; s++)
 		{
 			// Update envelope follower parameters
 			// Note: Converting threshold from linear to dB here since EnvelopeFollower expects dB
-			mEnvelopeFollowerParameters.attackTime_mSec = envAttack[s];
-			mEnvelopeFollowerParameters.releaseTime_mSec = envRelease[s];
 			mEnvelopeFollowerParameters.threshold_dB = 20.0 * log10(thresh_Linear[s]);
 			mEnvelopeFollowerParameters.sensitivity = sensitivity[s];
 			// update the base class parameters especially for AudioDetector class parameters